@@ -0,0 +1,117 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_BUNDLE_HPP_INCLUDED
+#define STANDARDESE_BUNDLE_HPP_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <type_safe/optional.hpp>
+
+namespace standardese
+{
+/// A view of the contents of a file stored in a bundle.
+struct bundle_entry
+{
+    const char* data;
+    std::size_t size;
+};
+
+/// Writes multiple output files into a single bundle file.
+///
+/// The contents of the files are appended to the bundle as they are added,
+/// an index mapping the file names to their offset and size is written at the end.
+/// A bundle that hasn't been finished is not valid and rejected by [standardese::bundle_reader].
+class bundle_writer
+{
+public:
+    /// \effects Creates the bundle file, overwriting an existing one.
+    /// \throws `std::runtime_error` if the file could not be created.
+    explicit bundle_writer(const std::string& path);
+
+    bundle_writer(const bundle_writer&) = delete;
+    bundle_writer& operator=(const bundle_writer&) = delete;
+
+    /// \effects Closes the file.
+    /// \notes It does not call [*finish](),
+    /// so the bundle of a writer that is destroyed early, e.g. due to an exception, stays invalid.
+    ~bundle_writer() noexcept = default;
+
+    /// \effects Appends a file with the given name and contents.
+    /// \throws `std::runtime_error` if writing the file failed,
+    /// `std::logic_error` if the bundle has already been finished.
+    /// \notes This function is thread safe.
+    /// \group add
+    void add(std::string name, const char* data, std::size_t size);
+
+    /// \group add
+    void add(std::string name, const std::string& contents)
+    {
+        add(std::move(name), contents.data(), contents.size());
+    }
+
+    /// \effects Writes the index and closes the file.
+    /// \throws `std::runtime_error` if writing the bundle failed,
+    /// `std::logic_error` if the bundle has already been finished.
+    /// \notes This function is thread safe.
+    void finish();
+
+private:
+    struct entry
+    {
+        std::string   name;
+        std::uint64_t offset, size;
+    };
+
+    std::mutex         mutex_;
+    std::string        path_;
+    std::ofstream      file_;
+    std::vector<entry> entries_;
+    std::uint64_t      offset_;
+    bool               finished_;
+};
+
+/// Reads a bundle file written by [standardese::bundle_writer].
+///
+/// On POSIX systems the file is memory mapped, otherwise it is read into memory.
+class bundle_reader
+{
+public:
+    /// \effects Opens the bundle and reads its index.
+    /// \throws `std::runtime_error` if the file could not be read or is not a bundle.
+    explicit bundle_reader(const std::string& path);
+
+    bundle_reader(const bundle_reader&) = delete;
+    bundle_reader& operator=(const bundle_reader&) = delete;
+
+    ~bundle_reader() noexcept;
+
+    /// \returns The contents of the file with the given name,
+    /// or an empty optional if the bundle does not contain it.
+    /// The contents are not copied, they stay valid as long as the reader.
+    type_safe::optional<bundle_entry> lookup(const std::string& name) const;
+
+    /// \returns The number of files in the bundle.
+    std::size_t size() const noexcept
+    {
+        return index_.size();
+    }
+
+private:
+    void read_index();
+
+    const char*                                   data_;
+    std::size_t                                   size_;
+    bool                                          mapped_;
+    std::vector<char>                             buffer_;
+    std::unordered_map<std::string, bundle_entry> index_;
+};
+} // namespace standardese
+
+#endif // STANDARDESE_BUNDLE_HPP_INCLUDED
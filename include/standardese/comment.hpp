@@ -5,8 +5,12 @@
 #ifndef STANDARDESE_COMMENT_HPP_INCLUDED
 #define STANDARDESE_COMMENT_HPP_INCLUDED
 
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "index.hpp"
 #include <standardese/comment/config.hpp>
@@ -67,15 +71,40 @@ public:
     }
 
 private:
-    std::unordered_map<const cppast::cpp_entity*, comment::doc_comment> map_;
+    // entry of an open addressing hash table mapping an entity to the index of its comment
+    struct slot
+    {
+        const cppast::cpp_entity* entity;
+        std::size_t               index;
+    };
+
+    // returns the slot of the entity or the empty slot where it would be inserted
+    std::size_t find_slot(const cppast::cpp_entity* entity) const noexcept;
+    void        insert_slot(const cppast::cpp_entity* entity, std::size_t index);
+
+    // the comments are stored densely, a deque keeps references valid on insertion
+    std::deque<comment::doc_comment> comments_;
+    std::vector<slot>                slots_; // size is zero or a power of two
     std::unordered_map<std::string, std::vector<type_safe::object_ref<const cppast::cpp_entity>>>
                                                           groups_;
     std::unordered_map<std::string, comment::doc_comment> modules_;
 };
 
+/// Caches the unique names of parent entities,
+/// so they are only computed once and not again for each child.
+///
+/// A cache must only be used together with one registry,
+/// and the comments of the parents must not change while it is used.
+using unique_name_cache = std::unordered_map<const cppast::cpp_entity*, std::string>;
+
 /// \returns The unique name of the given entity.
+/// \group lookup_unique_name
 std::string lookup_unique_name(const comment_registry& registry, const cppast::cpp_entity& e);
 
+/// \group lookup_unique_name
+std::string lookup_unique_name(const comment_registry& registry, const cppast::cpp_entity& e,
+                               unique_name_cache& cache);
+
 /// Parses the comments in a file.
 class file_comment_parser
 {
@@ -97,24 +126,37 @@ public:
     comment_registry finish();
 
 private:
-    bool register_commented(type_safe::object_ref<const cppast::cpp_entity> entity,
-                            comment::doc_comment comment, bool allow_cmd = true) const;
+    using uncommented_map = std::unordered_multimap<std::string, const cppast::cpp_entity*>;
 
-    void register_uncommented(type_safe::object_ref<const cppast::cpp_entity> entity) const;
-
-    type_safe::optional_ref<const comment::doc_comment> get_comment(
-        const cppast::cpp_entity& e) const
+    // the comments of a single file,
+    // they are collected without locking and merged by finish()
+    struct file_comments
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return registry_.get_comment(e);
-    }
-
-    std::string get_parent_unique_name(const cppast::cpp_entity& e) const;
-
-    mutable std::mutex                                                      mutex_;
-    mutable std::unordered_multimap<std::string, const cppast::cpp_entity*> uncommented_;
-    mutable comment_registry                                                registry_;
-    mutable std::vector<comment::parse_result>                              free_comments_;
+        comment_registry                   registry;
+        uncommented_map                    uncommented;
+        std::vector<comment::parse_result> free_comments;
+        unique_name_cache                  names;
+    };
+
+    bool register_commented(file_comments&                                  comments,
+                            type_safe::object_ref<const cppast::cpp_entity> entity,
+                            comment::doc_comment                            comment) const;
+
+    void register_uncommented(file_comments&                                  comments,
+                              type_safe::object_ref<const cppast::cpp_entity> entity) const;
+
+    // creating a parser is expensive, so they are reused for multiple files,
+    // the cmark parser resets itself after each comment
+    std::unique_ptr<comment::parser> acquire_parser() const;
+    void                             release_parser(std::unique_ptr<comment::parser> p) const;
+
+    mutable std::mutex                                    parser_mutex_;
+    mutable std::vector<std::unique_ptr<comment::parser>> parsers_;
+
+    // registry_ only contains the module comments until finish()
+    mutable std::mutex                 mutex_;
+    mutable comment_registry           registry_;
+    mutable std::vector<file_comments> files_;
 
     comment::config                                        config_;
     type_safe::object_ref<const cppast::diagnostic_logger> logger_;
@@ -6,6 +6,8 @@
 #define STANDARDESE_COMMENT_CONFIG_HPP_INCLUDED
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include <standardese/comment/commands.hpp>
@@ -73,8 +75,12 @@ namespace comment
         /// \returns The command or section corresponding to the given command string,
         /// or an invalid value, if it doesn't belong to anything.
         /// The command string does not contain the leading command character.
+        /// \group try_lookup
         unsigned try_lookup(const char* name) const noexcept;
 
+        /// \group try_lookup
+        unsigned try_lookup(const char* name, std::size_t size) const noexcept;
+
         /// \returns The name of a [standardese::markup::inline_section]().
         const char* inline_section_name(section_type section) const noexcept;
 
@@ -82,10 +88,14 @@ namespace comment
         const char* list_section_name(section_type section) const noexcept;
 
     private:
+        void update_command_table() noexcept;
+
         std::array<std::string, unsigned(inline_type::count)>  command_names_;
         std::array<std::string, unsigned(section_type::count)> inline_sections_;
         std::array<std::string, unsigned(section_type::count)> list_sections_;
-        char                                                   command_character_;
+        // open addressing hash table of the command names, stores index + 1 or 0 if empty
+        std::array<std::uint8_t, 128> command_table_;
+        char                          command_character_;
     };
 } // namespace comment
 } // namespace standardese
@@ -0,0 +1,82 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_DETAIL_HASH_HPP_INCLUDED
+#define STANDARDESE_DETAIL_HASH_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace standardese
+{
+/// \exclude
+namespace detail
+{
+    // 64bit FNV-1a hash
+    class hasher
+    {
+    public:
+        hasher() noexcept : hash_(14695981039346656037ull) {}
+
+        void combine(const char* data, std::size_t size) noexcept
+        {
+            for (auto ptr = data; ptr != data + size; ++ptr)
+            {
+                hash_ ^= static_cast<unsigned char>(*ptr);
+                hash_ *= 1099511628211ull;
+            }
+        }
+
+        void combine(const std::string& str) noexcept
+        {
+            // include the null terminator, so "ab" "c" and "a" "bc" are different
+            combine(str.c_str(), str.size() + 1u);
+        }
+
+        void combine(std::uint64_t value) noexcept
+        {
+            combine(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::uint64_t finish() const noexcept
+        {
+            return hash_;
+        }
+
+    private:
+        std::uint64_t hash_;
+    };
+
+    inline std::uint64_t hash_string(const char* str, std::size_t size) noexcept
+    {
+        hasher h;
+        h.combine(str, size);
+        return h.finish();
+    }
+
+    inline std::uint64_t hash_pointer(const void* ptr) noexcept
+    {
+        // objects are heap allocated, so the lower bits of the address are always zero,
+        // multiply with the golden ratio and take the upper half to spread the bits
+        auto hash = std::uint64_t(reinterpret_cast<std::uintptr_t>(ptr)) * 0x9E3779B97F4A7C15ull;
+        return hash >> 32u;
+    }
+
+    // linear probing in an open addressing hash table whose size is a power of two
+    // returns the index of the first slot, starting at the hash, for which `stop(index)` is true
+    // requires: the table has a slot where it stops, e.g. an empty one
+    template <typename Predicate>
+    std::size_t probe_slot(std::uint64_t hash, std::size_t table_size, Predicate stop)
+    {
+        auto mask = table_size - 1u;
+        auto i    = std::size_t(hash) & mask;
+        while (!stop(i))
+            i = (i + 1u) & mask;
+        return i;
+    }
+} // namespace detail
+} // namespace standardese
+
+#endif // STANDARDESE_DETAIL_HASH_HPP_INCLUDED
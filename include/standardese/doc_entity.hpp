@@ -14,6 +14,7 @@
 
 #include "index.hpp"
 #include <standardese/comment/doc_comment.hpp>
+#include <standardese/interned_string.hpp>
 #include <standardese/markup/code_block.hpp>
 #include <standardese/markup/documentation.hpp>
 #include <standardese/markup/index.hpp>
@@ -203,6 +204,12 @@ public:
 
     /// \returns The link name of the entity.
     const std::string& link_name() const noexcept
+    {
+        return link_name_.str();
+    }
+
+    /// \returns The interned link name of the entity.
+    const interned_string& interned_link_name() const noexcept
     {
         return link_name_;
     }
@@ -253,7 +260,7 @@ public:
 
 private:
     doc_entity(std::string link_name, type_safe::optional_ref<const comment::doc_comment> comment)
-    : link_name_(std::move(link_name)), comment_(comment)
+    : link_name_(link_name), comment_(comment)
     {}
 
     template <typename T>
@@ -322,7 +329,7 @@ private:
     /// \exclude
     virtual void do_generate_code(cppast::code_generator& generator) const = 0;
 
-    std::string                                         link_name_;
+    interned_string                                     link_name_;
     std::vector<std::unique_ptr<doc_entity>>            children_;
     type_safe::optional_ref<const doc_entity>           parent_;
     type_safe::optional_ref<const comment::doc_comment> comment_;
@@ -443,7 +450,7 @@ private:
         if (in_member_group() || !comment())
             return parent().value().get_documentation_id();
         else
-            return markup::block_id(link_name());
+            return markup::block_id(interned_link_name());
     }
 
     std::unique_ptr<markup::documentation_entity> do_generate_documentation(
@@ -561,7 +568,7 @@ private:
 
     markup::block_id do_get_id() const override
     {
-        return markup::block_id(begin()->link_name());
+        return markup::block_id(begin()->interned_link_name());
     }
 
     std::unique_ptr<markup::documentation_entity> do_generate_documentation(
@@ -616,7 +623,7 @@ private:
 
     markup::block_id do_get_id() const override
     {
-        return markup::block_id(link_name());
+        return markup::block_id(interned_link_name());
     }
 
     std::unique_ptr<markup::documentation_entity> do_generate_documentation(
@@ -679,7 +686,7 @@ private:
 
     markup::block_id do_get_id() const override
     {
-        return markup::block_id(link_name());
+        return markup::block_id(interned_link_name());
     }
 
     std::unique_ptr<markup::documentation_entity> do_generate_documentation(
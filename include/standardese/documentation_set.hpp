@@ -0,0 +1,111 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_DOCUMENTATION_SET_HPP_INCLUDED
+#define STANDARDESE_DOCUMENTATION_SET_HPP_INCLUDED
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <type_safe/optional_ref.hpp>
+#include <type_safe/reference.hpp>
+
+#include <standardese/doc_entity.hpp>
+#include <standardese/linker.hpp>
+#include <standardese/markup/document.hpp>
+#include <standardese/markup/generator.hpp>
+
+namespace cppast
+{
+class diagnostic_logger;
+} // namespace cppast
+
+namespace standardese
+{
+/// A set of documents that are rendered on demand.
+///
+/// It keeps the documents, the files they were generated from and the linker resident.
+/// The links of a document are resolved when it is requested for the first time,
+/// and the rendered output of the most recently requested documents is cached.
+class documentation_set
+{
+public:
+    /// The default maximal number of bytes of rendered output that are cached.
+    static constexpr std::size_t default_cache_size = 64u * 1024u * 1024u;
+
+    /// \effects Creates it given the files, the documents generated from them,
+    /// and the linker all the documentations have been registered in.
+    /// Unresolved links are logged to the logger.
+    /// At most `cache_size` bytes of rendered output are cached.
+    /// The linker is frozen by the constructor, if that hasn't been done already,
+    /// so no documentation can be registered afterwards.
+    /// \requires The logger must live as long as the set.
+    documentation_set(std::vector<std::unique_ptr<doc_cpp_file>>             files,
+                      std::vector<std::unique_ptr<markup::document_entity>> documents,
+                      std::unique_ptr<linker>                                l,
+                      type_safe::object_ref<const cppast::diagnostic_logger> logger,
+                      std::size_t cache_size = default_cache_size);
+
+    documentation_set(const documentation_set&) = delete;
+    documentation_set& operator=(const documentation_set&) = delete;
+
+    /// \effects Registers a generator for the output format with the given name.
+    /// \notes This function is *not* thread safe,
+    /// all formats must be registered before documents are rendered.
+    void add_format(std::string name, markup::generator generator);
+
+    /// \effects Resolves the links of the document, unless that has been done already.
+    /// \returns The document with the given output name,
+    /// or an empty optional if there is none.
+    /// \notes This function is thread safe.
+    type_safe::optional_ref<const markup::document_entity> lookup(
+        const std::string& output_name) const;
+
+    /// \effects Renders the document with the given output name in the given format,
+    /// unless the output is still cached.
+    /// \returns The rendered document,
+    /// or `nullptr` if there is no such document or format.
+    /// The result stays valid even if it is evicted from the cache.
+    /// \notes This function is thread safe.
+    std::shared_ptr<const std::string> render(const std::string& output_name,
+                                              const std::string& format) const;
+
+private:
+    struct document
+    {
+        std::unique_ptr<markup::document_entity> entity;
+        std::once_flag                           resolved;
+
+        explicit document(std::unique_ptr<markup::document_entity> entity)
+        : entity(std::move(entity))
+        {}
+    };
+
+    using cache_list = std::list<std::pair<std::string, std::shared_ptr<const std::string>>>;
+
+    const markup::document_entity& get_resolved(document& doc) const;
+
+    std::shared_ptr<const std::string> get_cached(const std::string& key) const;
+    void insert_cached(std::string key, std::shared_ptr<const std::string> output) const;
+
+    std::vector<std::unique_ptr<doc_cpp_file>>                 files_;
+    std::unique_ptr<linker>                                    linker_;
+    type_safe::object_ref<const cppast::diagnostic_logger>     logger_;
+    std::unordered_map<std::string, std::unique_ptr<document>> documents_;
+    std::unordered_map<std::string, markup::generator>         formats_;
+
+    // the least recently used output is at the back of the list
+    mutable std::mutex                                             cache_mutex_;
+    mutable cache_list                                             cache_list_;
+    mutable std::unordered_map<std::string, cache_list::iterator> cache_;
+    mutable std::size_t                                            cached_size_;
+    std::size_t                                                    max_cached_size_;
+};
+} // namespace standardese
+
+#endif // STANDARDESE_DOCUMENTATION_SET_HPP_INCLUDED
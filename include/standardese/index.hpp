@@ -5,6 +5,8 @@
 #ifndef STANDARDESE_INDEX_HPP_INCLUDED
 #define STANDARDESE_INDEX_HPP_INCLUDED
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -66,24 +68,42 @@ public:
 private:
     struct entity
     {
-        std::string name, scope;
+        std::string key; // scope followed by name, used for sorting
+        std::size_t scope_size;
+        std::size_t sequence; // order of registration, used for sorting equal keys
         type_safe::variant<std::unique_ptr<markup::entity_index_item>,
                            markup::namespace_documentation::builder>
             doc;
 
-        entity(std::unique_ptr<markup::entity_index_item> doc, std::string name, std::string scope)
-        : name(std::move(name)), scope(std::move(scope)), doc(std::move(doc))
-        {}
-
-        entity(markup::namespace_documentation::builder doc, std::string name, std::string scope)
-        : name(std::move(name)), scope(std::move(scope)), doc(std::move(doc))
-        {}
+        entity(std::unique_ptr<markup::entity_index_item> doc, const std::string& name,
+               std::string scope)
+        : key(std::move(scope)), scope_size(key.size()), sequence(0u), doc(std::move(doc))
+        {
+            key += name;
+        }
+
+        entity(markup::namespace_documentation::builder doc, const std::string& name,
+               std::string scope)
+        : key(std::move(scope)), scope_size(key.size()), sequence(0u), doc(std::move(doc))
+        {
+            key += name;
+        }
     };
 
     void insert(entity e) const;
 
-    mutable std::mutex          mutex_;
-    mutable std::vector<entity> entities_; // sorted by scope, then name
+    // entities are appended to one of multiple buffers, chosen by the current thread,
+    // and only sorted once in generate()
+    struct buffer
+    {
+        std::mutex          mutex;
+        std::vector<entity> entities;
+    };
+
+    static constexpr std::size_t no_buffers = 16u;
+
+    mutable std::array<buffer, no_buffers> buffers_;
+    mutable std::atomic<std::size_t>       next_sequence_{0u};
 };
 
 /// Registers all entities that needs registration.
@@ -0,0 +1,76 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_INTERNED_STRING_HPP_INCLUDED
+#define STANDARDESE_INTERNED_STRING_HPP_INCLUDED
+
+#include <functional>
+#include <string>
+
+namespace standardese
+{
+/// A string stored in a process-wide string pool.
+///
+/// Equal strings share the same storage,
+/// so copying, comparing and hashing it only works on a pointer.
+/// The storage is never freed.
+class interned_string
+{
+public:
+    /// \effects Creates the empty string.
+    interned_string() noexcept;
+
+    /// \effects Interns the given string.
+    /// \notes This function is thread safe.
+    explicit interned_string(const std::string& str);
+
+    /// \returns The string.
+    const std::string& str() const noexcept
+    {
+        return *str_;
+    }
+
+    /// \returns Whether or not the string is empty.
+    bool empty() const noexcept
+    {
+        return str_->empty();
+    }
+
+    /// \returns A hash of the string.
+    std::size_t hash() const noexcept
+    {
+        return std::hash<const std::string*>{}(str_);
+    }
+
+    /// \returns Whether or not the two strings are (un-)equal.
+    /// \group interned_string_equal interned_string comparison
+    friend bool operator==(const interned_string& a, const interned_string& b) noexcept
+    {
+        return a.str_ == b.str_;
+    }
+
+    /// \group interned_string_equal
+    friend bool operator!=(const interned_string& a, const interned_string& b) noexcept
+    {
+        return a.str_ != b.str_;
+    }
+
+private:
+    const std::string* str_;
+};
+} // namespace standardese
+
+namespace std
+{
+template <>
+struct hash<standardese::interned_string>
+{
+    std::size_t operator()(const standardese::interned_string& str) const noexcept
+    {
+        return str.hash();
+    }
+};
+} // namespace std
+
+#endif // STANDARDESE_INTERNED_STRING_HPP_INCLUDED
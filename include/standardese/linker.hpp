@@ -5,11 +5,15 @@
 #ifndef STANDARDESE_LINKER_HPP_INCLUDED
 #define STANDARDESE_LINKER_HPP_INCLUDED
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <mutex>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
+#include <type_safe/optional.hpp>
 #include <type_safe/variant.hpp>
 
 #include <standardese/markup/link.hpp>
@@ -39,10 +43,26 @@ public:
     /// All unresolved links with that name will resolve to the given documentation.
     /// If `force` is `true`, it will replace a previous registered documentation.
     /// \returns `false` if the link name was used twice.
+    /// \throws `std::logic_error` if the linker has already been frozen.
     /// \notes This function is thread safe.
     bool register_documentation(std::string link_name, const markup::document_entity& document,
                                 const markup::block_id& documentation, bool force = false) const;
 
+    /// \effects Freezes the linker,
+    /// i.e. moves all registered link names into an immutable hash table.
+    /// Afterwards lookups no longer need any locking.
+    /// Does nothing if the linker is already frozen.
+    /// \requires This function must be called after all documentations have been registered,
+    /// no documentation can be registered afterwards.
+    /// \notes This function is *not* thread safe.
+    void freeze() const;
+
+    /// \returns Whether or not [*freeze]() has been called.
+    bool is_frozen() const noexcept
+    {
+        return frozen_;
+    }
+
     /// \returns A reference to the documentation for the given linke name, if there is any.
     /// \notes This function is thread safe.
     type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url>
@@ -50,8 +70,33 @@ public:
                              std::string                                       link_name) const;
 
 private:
-    mutable std::mutex                                               mutex_;
-    mutable std::unordered_map<std::string, markup::block_reference> map_;
+    // the link names are distributed over multiple independently locked maps,
+    // so concurrent registrations and lookups rarely contend
+    struct shard
+    {
+        std::mutex                                               mutex;
+        std::unordered_map<std::string, markup::block_reference> map;
+    };
+
+    static constexpr std::size_t no_shards = 32u;
+
+    struct frozen_entry
+    {
+        std::string             link_name;
+        markup::block_reference reference;
+    };
+
+    shard& get_shard(const std::string& link_name) const noexcept;
+
+    type_safe::optional<markup::block_reference> lookup(const std::string& link_name) const;
+
+    mutable std::array<shard, no_shards> shards_;
+
+    // open addressing hash table of the frozen link names,
+    // slots store the index of the entry plus one, zero marks an empty slot
+    mutable std::vector<frozen_entry>  frozen_entries_;
+    mutable std::vector<std::uint32_t> frozen_table_;
+    mutable bool                       frozen_ = false;
 
     std::map<std::string, std::string> external_doc_;
 };
@@ -5,8 +5,12 @@
 #ifndef STANDARDESE_MARKUP_BLOCK_HPP_INCLUDED
 #define STANDARDESE_MARKUP_BLOCK_HPP_INCLUDED
 
+#include <cstdint>
+#include <utility>
+
 #include <type_safe/optional.hpp>
 
+#include <standardese/interned_string.hpp>
 #include <standardese/markup/entity.hpp>
 
 namespace standardese
@@ -59,40 +63,90 @@ namespace markup
     /// The id of a [standardese::markup::block_entity]().
     ///
     /// It must be unique and should only consist of alphanumerics or `-`.
+    /// The id either owns its string or refers to an interned string,
+    /// the latter is used for the stable ids of entities, like their link names.
+    /// Both are stored in a single pointer,
+    /// so the id is as small as an [standardese::interned_string]().
     class block_id
     {
     public:
         /// \effects Creates an empty id.
-        explicit block_id() : block_id("") {}
+        explicit block_id() noexcept : block_id(interned_string()) {}
 
         /// \effects Creates it given the string representation.
-        explicit block_id(std::string id) : id_(std::move(id)) {}
+        explicit block_id(std::string id)
+        : ptr_(id.empty() ? to_ptr(interned_string())
+                          : reinterpret_cast<std::uintptr_t>(new std::string(std::move(id)))
+                                | owned_tag)
+        {}
+
+        /// \effects Creates it given the already interned string representation.
+        explicit block_id(interned_string id) noexcept : ptr_(to_ptr(id)) {}
+
+        block_id(const block_id& other)
+        : ptr_(other.is_interned()
+                   ? other.ptr_
+                   : reinterpret_cast<std::uintptr_t>(new std::string(other.as_str())) | owned_tag)
+        {}
+
+        block_id(block_id&& other) noexcept : ptr_(other.ptr_)
+        {
+            other.ptr_ = to_ptr(interned_string());
+        }
+
+        ~block_id() noexcept
+        {
+            if (!is_interned())
+                delete &as_str();
+        }
+
+        block_id& operator=(block_id other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            return *this;
+        }
 
         /// \returns Whether or not the id is empty.
         bool empty() const noexcept
         {
-            return id_.empty();
+            return as_str().empty();
         }
 
         /// \returns The string representation of the id.
         const std::string& as_str() const noexcept
         {
-            return id_;
+            return *reinterpret_cast<const std::string*>(ptr_ & ~owned_tag);
         }
 
         /// \returns The escaped string representaton.
         std::string as_output_str() const;
 
+        /// \returns Whether or not two ids are (un-)equal.
+        /// \group block_id_equal block_id comparison
+        friend bool operator==(const block_id& a, const block_id& b) noexcept
+        {
+            if (a.is_interned() && b.is_interned())
+                return a.ptr_ == b.ptr_;
+            else
+                return a.as_str() == b.as_str();
+        }
+
     private:
-        std::string id_;
-    };
+        // the lowest bit of the pointer is set if the id owns the string
+        static constexpr std::uintptr_t owned_tag = 1u;
 
-    /// \returns Whether or not two ids are (un-)equal.
-    /// \group block_id_equal block_id comparison
-    inline bool operator==(const block_id& a, const block_id& b) noexcept
-    {
-        return a.as_str() == b.as_str();
-    }
+        static std::uintptr_t to_ptr(const interned_string& str) noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(&str.str());
+        }
+
+        bool is_interned() const noexcept
+        {
+            return (ptr_ & owned_tag) == 0u;
+        }
+
+        std::uintptr_t ptr_;
+    };
 
     /// \group block_id_equal
     inline bool operator!=(const block_id& a, const block_id& b) noexcept
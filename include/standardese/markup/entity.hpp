@@ -5,6 +5,7 @@
 #ifndef STANDARDESE_MARKUP_ENTITY_HPP_INCLUDED
 #define STANDARDESE_MARKUP_ENTITY_HPP_INCLUDED
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -55,6 +56,22 @@ namespace markup
             return do_clone();
         }
 
+        /// \effects Makes all entities use a pool of fixed size blocks instead of `::operator new`,
+        /// which is much faster for the millions of nodes in the markup of a big project.
+        /// The memory of the pool is only released once the threads that allocated it
+        /// have exited and all of its entities have been destroyed.
+        /// \returns Whether or not the pool is used,
+        /// it can no longer be enabled after the first entity has been allocated.
+        /// \notes This function is thread safe.
+        static bool enable_pool() noexcept;
+
+        /// \effects Allocates the memory of an entity,
+        /// using the pool if it has been enabled.
+        static void* operator new(std::size_t size);
+
+        /// \effects Frees the memory of an entity.
+        static void operator delete(void* ptr) noexcept;
+
     protected:
         entity() noexcept = default;
 
@@ -23,7 +23,13 @@ namespace markup
     /// Renders an entity to a string.
     ///
     /// \returns The string representation of the entity in the given format.
-    std::string render(generator gen, const entity& e);
+    std::string render(const generator& gen, const entity& e);
+
+    /// Renders an entity into an existing string.
+    ///
+    /// \effects Appends the string representation of the entity in the given format to `out`,
+    /// without going through a temporary string.
+    void render(const generator& gen, const entity& e, std::string& out);
 
     /// An HTML generator.
     ///
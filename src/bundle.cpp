@@ -0,0 +1,196 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/bundle.hpp>
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    define STANDARDESE_DETAIL_MMAP 1
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    define STANDARDESE_DETAIL_MMAP 0
+#endif
+
+using namespace standardese;
+
+// The bundle consists of the contents of all files, followed by the index and the footer.
+// The index stores for each file its offset, size, the size of the name and then the name.
+// The footer stores the offset of the index, the number of files and a magic string.
+// All integers are stored as 64bit little endian.
+namespace
+{
+constexpr char        magic[]     = "stdbndl1";
+constexpr std::size_t magic_size  = sizeof(magic) - 1u;
+constexpr std::size_t footer_size = 2u * sizeof(std::uint64_t) + magic_size;
+
+void write_integer(std::string& out, std::uint64_t value)
+{
+    for (auto i = 0u; i != sizeof(value); ++i)
+        out.push_back(char((value >> (i * 8u)) & 0xFF));
+}
+
+std::uint64_t read_integer(const char* in)
+{
+    std::uint64_t result = 0u;
+    for (auto i = 0u; i != sizeof(result); ++i)
+        result |= std::uint64_t(static_cast<unsigned char>(in[i])) << (i * 8u);
+    return result;
+}
+
+[[noreturn]] void invalid_bundle(const std::string& msg)
+{
+    throw std::runtime_error("invalid bundle: " + msg);
+}
+} // namespace
+
+bundle_writer::bundle_writer(const std::string& path)
+: path_(path), file_(path, std::ios::binary | std::ios::trunc), offset_(0u), finished_(false)
+{
+    if (!file_)
+        throw std::runtime_error("unable to create bundle '" + path + "'");
+}
+
+void bundle_writer::add(std::string name, const char* data, std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_)
+        throw std::logic_error("cannot add '" + name + "' to finished bundle '" + path_ + "'");
+
+    file_.write(data, static_cast<std::streamsize>(size));
+    if (!file_)
+        throw std::runtime_error("unable to write '" + name + "' to bundle '" + path_ + "'");
+
+    entries_.push_back(entry{std::move(name), offset_, size});
+    offset_ += size;
+}
+
+void bundle_writer::finish()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_)
+        throw std::logic_error("bundle '" + path_ + "' has already been finished");
+
+    std::string index;
+    for (auto& e : entries_)
+    {
+        write_integer(index, e.offset);
+        write_integer(index, e.size);
+        write_integer(index, e.name.size());
+        index += e.name;
+    }
+    write_integer(index, offset_);
+    write_integer(index, entries_.size());
+    index.append(magic, magic_size);
+
+    file_.write(index.data(), static_cast<std::streamsize>(index.size()));
+    file_.close();
+    if (!file_)
+        throw std::runtime_error("unable to write bundle '" + path_ + "'");
+
+    // only now the bundle is complete
+    finished_ = true;
+}
+
+bundle_reader::bundle_reader(const std::string& path)
+: data_(nullptr), size_(0u), mapped_(false)
+{
+#if STANDARDESE_DETAIL_MMAP
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::runtime_error("unable to open bundle '" + path + "'");
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        auto ptr = ::mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED)
+        {
+            data_   = static_cast<const char*>(ptr);
+            size_   = std::size_t(info.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!mapped_)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("unable to open bundle '" + path + "'");
+        buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    try
+    {
+        read_index();
+    }
+    catch (...)
+    {
+#if STANDARDESE_DETAIL_MMAP
+        if (mapped_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+        throw;
+    }
+}
+
+bundle_reader::~bundle_reader() noexcept
+{
+#if STANDARDESE_DETAIL_MMAP
+    if (mapped_)
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+void bundle_reader::read_index()
+{
+    if (size_ < footer_size)
+        invalid_bundle("file too small");
+
+    auto footer = data_ + size_ - footer_size;
+    if (std::memcmp(footer + 2u * sizeof(std::uint64_t), magic, magic_size) != 0)
+        invalid_bundle("magic string not found");
+
+    auto index_offset = read_integer(footer);
+    auto no_entries   = read_integer(footer + sizeof(std::uint64_t));
+    if (index_offset > size_ - footer_size)
+        invalid_bundle("index out of range");
+
+    auto cur = data_ + index_offset;
+    for (auto i = std::uint64_t(0); i != no_entries; ++i)
+    {
+        if (std::size_t(footer - cur) < 3u * sizeof(std::uint64_t))
+            invalid_bundle("index truncated");
+        auto offset    = read_integer(cur);
+        auto size      = read_integer(cur + sizeof(std::uint64_t));
+        auto name_size = read_integer(cur + 2u * sizeof(std::uint64_t));
+        cur += 3u * sizeof(std::uint64_t);
+
+        if (name_size > std::size_t(footer - cur))
+            invalid_bundle("index truncated");
+        if (offset > index_offset || size > index_offset - offset)
+            invalid_bundle("file contents out of range");
+
+        std::string name(cur, std::size_t(name_size));
+        cur += name_size;
+        index_.emplace(std::move(name), bundle_entry{data_ + offset, std::size_t(size)});
+    }
+}
+
+type_safe::optional<bundle_entry> bundle_reader::lookup(const std::string& name) const
+{
+    auto iter = index_.find(name);
+    if (iter == index_.end())
+        return type_safe::nullopt;
+    return iter->second;
+}
@@ -9,6 +9,9 @@
 #include <cppast/visitor.hpp>
 
 #include <algorithm>
+#include <cassert>
+
+#include <standardese/detail/hash.hpp>
 
 #include "get_special_entity.hpp"
 
@@ -16,10 +19,17 @@ using namespace standardese;
 
 void comment_registry::merge(comment_registry&& other)
 {
-    map_.insert(std::make_move_iterator(other.map_.begin()),
-                std::make_move_iterator(other.map_.end()));
-    groups_.insert(std::make_move_iterator(other.groups_.begin()),
-                   std::make_move_iterator(other.groups_.end()));
+    for (auto& s : other.slots_)
+        if (s.entity && (slots_.empty() || !slots_[find_slot(s.entity)].entity))
+        {
+            insert_slot(s.entity, comments_.size());
+            comments_.push_back(std::move(other.comments_[s.index]));
+        }
+    for (auto& group : other.groups_)
+    {
+        auto& members = groups_[group.first];
+        members.insert(members.end(), group.second.begin(), group.second.end());
+    }
     modules_.insert(std::make_move_iterator(other.modules_.begin()),
                     std::make_move_iterator(other.modules_.end()));
 }
@@ -27,13 +37,16 @@ void comment_registry::merge(comment_registry&& other)
 bool comment_registry::register_comment(type_safe::object_ref<const cppast::cpp_entity> entity,
                                         comment::doc_comment                            comment)
 {
-    auto iter = map_.find(&*entity);
-    if (iter == map_.end())
+    auto existing = slots_.empty() ? nullptr : &slots_[find_slot(&*entity)];
+    if (!existing || !existing->entity)
+    {
         // not in map yet
-        map_.emplace(&*entity, std::move(comment));
+        insert_slot(&*entity, comments_.size());
+        comments_.push_back(std::move(comment));
+    }
     else
     {
-        auto& stored_comment = iter->second;
+        auto& stored_comment = comments_[existing->index];
         if (stored_comment.brief_section() || !stored_comment.sections().empty())
             // already have a documentation
             return false;
@@ -59,10 +72,13 @@ type_safe::optional_ref<const comment::doc_comment> comment_registry::get_commen
     if (cppast::is_templated(*entity))
         entity = &entity->parent().value();
 
-    auto iter = map_.find(entity);
-    if (iter == map_.end())
+    if (slots_.empty())
         return type_safe::nullopt;
-    return type_safe::ref(iter->second);
+
+    auto& s = slots_[find_slot(entity)];
+    if (!s.entity)
+        return type_safe::nullopt;
+    return type_safe::ref(comments_[s.index]);
 }
 
 type_safe::optional_ref<const comment::doc_comment> comment_registry::get_comment(
@@ -74,6 +90,29 @@ type_safe::optional_ref<const comment::doc_comment> comment_registry::get_commen
     return type_safe::ref(iter->second);
 }
 
+std::size_t comment_registry::find_slot(const cppast::cpp_entity* entity) const noexcept
+{
+    assert(!slots_.empty());
+    return detail::probe_slot(detail::hash_pointer(entity), slots_.size(), [&](std::size_t i) {
+        return slots_[i].entity == entity || !slots_[i].entity;
+    });
+}
+
+void comment_registry::insert_slot(const cppast::cpp_entity* entity, std::size_t index)
+{
+    // keep the load factor at most 1/2
+    if (2u * (comments_.size() + 1u) > slots_.size())
+    {
+        std::vector<slot> old(slots_.empty() ? 64u : 2u * slots_.size(), slot{nullptr, 0u});
+        old.swap(slots_);
+        for (auto& s : old)
+            if (s.entity)
+                slots_[find_slot(s.entity)] = s;
+    }
+
+    slots_[find_slot(entity)] = slot{entity, index};
+}
+
 namespace
 {
 cppast::source_location make_location(const cppast::cpp_entity&   entity,
@@ -174,9 +213,35 @@ void process_inlines(const cppast::diagnostic_logger&            logger,
 }
 } // namespace
 
+std::unique_ptr<comment::parser> file_comment_parser::acquire_parser() const
+{
+    {
+        std::lock_guard<std::mutex> lock(parser_mutex_);
+        if (!parsers_.empty())
+        {
+            auto result = std::move(parsers_.back());
+            parsers_.pop_back();
+            return result;
+        }
+    }
+
+    return std::unique_ptr<comment::parser>(new comment::parser(config_));
+}
+
+void file_comment_parser::release_parser(std::unique_ptr<comment::parser> p) const
+{
+    std::lock_guard<std::mutex> lock(parser_mutex_);
+    parsers_.push_back(std::move(p));
+}
+
 void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> file) const
 {
-    comment::parser p(config_);
+    auto  parser = acquire_parser();
+    auto& p      = *parser;
+
+    // the entities are visited top-down, so a parent's comment is registered before its children
+    // and the unique names can be cached
+    file_comments comments;
 
     // add matched comments
     cppast::visit(*file, [&](const cppast::cpp_entity& entity, const cppast::visitor_info& info) {
@@ -187,19 +252,18 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
         {
             auto register_commented = [&](type_safe::object_ref<const cppast::cpp_entity> e,
                                           comment::doc_comment                            comment) {
-                this->register_commented(e, std::move(comment));
+                this->register_commented(comments, e, std::move(comment));
             };
             auto register_uncommented = [&](type_safe::object_ref<const cppast::cpp_entity> e) {
-                this->register_uncommented(e);
+                this->register_uncommented(comments, e);
             };
 
             // parse comment
             type_safe::optional<comment::parse_result> comment;
             try
             {
-                comment = type_safe::copy(entity.comment()).map([&](const std::string& str) {
-                    return comment::parse(p, str, true);
-                });
+                if (entity.comment())
+                    comment = comment::parse(p, entity.comment().value(), true);
             }
             catch (comment::parse_error& ex)
             {
@@ -238,7 +302,7 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
         if (comment::is_file(comment.entity))
         {
             // comment for current file
-            if (!register_commented(file, std::move(comment.comment.value())))
+            if (!register_commented(comments, file, std::move(comment.comment.value())))
                 logger_->log("standardese comment",
                              make_semantic_diagnostic(*file, "multiple file comments"));
         }
@@ -259,7 +323,7 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
         else if (auto name = comment::get_remote_entity(comment.entity))
         {
             assert(comment.comment);
-            free_comments_.push_back(std::move(comment));
+            comments.free_comments.push_back(std::move(comment));
         }
         else
             logger_
@@ -267,51 +331,78 @@ void file_comment_parser::parse(type_safe::object_ref<const cppast::cpp_file> fi
                       make_diagnostic(cppast::source_location::make_file(file->name(), free.line),
                                       "unmatched comment doesn't have a remote entity specified"));
     }
+
+    release_parser(std::move(parser));
+
+    comments.names.clear(); // not needed anymore
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.push_back(std::move(comments));
+}
+
+namespace
+{
+bool register_comment(comment_registry&                               registry,
+                      type_safe::object_ref<const cppast::cpp_entity> entity,
+                      comment::doc_comment                            comment)
+{
+    if (comment.metadata().group())
+        registry.add_to_group(comment.metadata().group().value().name(), entity);
+    return registry.register_comment(entity, std::move(comment));
 }
+} // namespace
 
 comment_registry file_comment_parser::finish()
 {
-    // find suitable entities for the free comments
-    for (auto& free : free_comments_)
+    uncommented_map uncommented;
+    for (auto& file : files_)
     {
-        auto result = uncommented_.equal_range(comment::get_remote_entity(free.entity).value());
-        if (result.first != result.second)
+        registry_.merge(std::move(file.registry));
+        uncommented.insert(std::make_move_iterator(file.uncommented.begin()),
+                           std::make_move_iterator(file.uncommented.end()));
+    }
+
+    // find suitable entities for the free comments
+    for (auto& file : files_)
+        for (auto& free : file.free_comments)
         {
-            auto metadata = free.comment.value().metadata();
+            auto result = uncommented.equal_range(comment::get_remote_entity(free.entity).value());
+            if (result.first != result.second)
+            {
+                auto metadata = free.comment.value().metadata();
 
-            register_commented(type_safe::ref(*result.first->second),
-                               std::move(free.comment.value()), false);
+                register_comment(registry_, type_safe::ref(*result.first->second),
+                                 std::move(free.comment.value()));
 
-            for (auto cur = std::next(result.first); cur != result.second; ++cur)
-                register_commented(type_safe::ref(*cur->second),
-                                   comment::doc_comment(metadata, nullptr, {}), false);
+                for (auto cur = std::next(result.first); cur != result.second; ++cur)
+                    register_comment(registry_, type_safe::ref(*cur->second),
+                                     comment::doc_comment(metadata, nullptr, {}));
 
-            uncommented_.erase(result.first, result.second);
+                uncommented.erase(result.first, result.second);
+            }
+            else
+                logger_->log("standardese comment",
+                             make_diagnostic(cppast::source_location(),
+                                             "unable to find matching entity '",
+                                             comment::get_remote_entity(free.entity).value(),
+                                             "' for comment"));
         }
-        else
-            logger_->log("standardese comment",
-                         make_diagnostic(cppast::source_location(),
-                                         "unable to find matching entity '",
-                                         comment::get_remote_entity(free.entity).value(),
-                                         "' for comment"));
-    }
+    files_.clear();
 
     return std::move(registry_);
 }
 
-bool file_comment_parser::register_commented(type_safe::object_ref<const cppast::cpp_entity> entity,
-                                             comment::doc_comment comment, bool allow_cmd) const
+bool file_comment_parser::register_commented(
+    file_comments& comments, type_safe::object_ref<const cppast::cpp_entity> entity,
+    comment::doc_comment comment) const
 {
     auto cmd_comment = !comment.brief_section() && comment.sections().empty();
+    auto result      = register_comment(comments.registry, entity, std::move(comment));
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (comment.metadata().group())
-        registry_.add_to_group(comment.metadata().group().value().name(), entity);
-    auto result = registry_.register_comment(entity, std::move(comment));
-
-    if (cmd_comment && allow_cmd)
+    if (cmd_comment)
         // a pure "command" comment, allow later sections
-        uncommented_.emplace(lookup_unique_name(registry_, *entity), &*entity);
+        comments.uncommented.emplace(lookup_unique_name(comments.registry, *entity,
+                                                        comments.names),
+                                     &*entity);
 
     return result;
 }
@@ -412,13 +503,13 @@ std::string get_separator(const cppast::cpp_entity& e)
         return "::";
 }
 
-std::string get_full_unique_name(const std::string& parent, const cppast::cpp_entity& e,
+std::string get_full_unique_name(std::string parent, const cppast::cpp_entity& e,
                                  const std::string& e_name)
 {
-    std::string result = parent;
+    std::string result = std::move(parent);
     if (e_name.empty())
         return result;
-    else if (!(parent.empty() || parent.back() == ':' || parent.back() == '.'
+    else if (!(result.empty() || result.back() == ':' || result.back() == '.'
                || e_name.front() == ':' || e_name.front() == '.'))
         result += get_separator(e);
 
@@ -430,7 +521,8 @@ std::string get_full_unique_name(const std::string& parent, const cppast::cpp_en
 }
 
 template <class Lookup>
-std::string lookup_parent_unique_name(const Lookup& get_comment, const cppast::cpp_entity& e)
+std::string lookup_parent_unique_name(const Lookup& get_comment, const cppast::cpp_entity& e,
+                                      unique_name_cache& cache)
 {
     auto parent = e.parent();
     while (parent && (cppast::is_templated(parent.value()) || cppast::is_friended(parent.value())))
@@ -445,6 +537,10 @@ std::string lookup_parent_unique_name(const Lookup& get_comment, const cppast::c
     if (!need_name)
         return "";
 
+    auto cached = cache.find(&parent.value());
+    if (cached != cache.end())
+        return cached->second;
+
     auto result
         = parent
               .map([&](const cppast::cpp_entity& p) {
@@ -452,43 +548,49 @@ std::string lookup_parent_unique_name(const Lookup& get_comment, const cppast::c
                                                                    : type_safe::nullopt;
               })
               .map([](const comment::doc_comment& c) { return c.metadata().unique_name(); });
+    std::string name;
     if (result)
-        return result.value();
+        name = result.value();
+    else
+        // parent doesn't have a unique name
+        name = get_full_unique_name(lookup_parent_unique_name(get_comment, parent.value(), cache),
+                                    parent.value(), get_unique_name(parent.value()));
 
-    // parent doesn't have a unique name
-    return get_full_unique_name(lookup_parent_unique_name(get_comment, parent.value()),
-                                parent.value(), get_unique_name(parent.value()));
+    cache.emplace(&parent.value(), name);
+    return name;
 }
 } // namespace
 
 void file_comment_parser::register_uncommented(
-    type_safe::object_ref<const cppast::cpp_entity> entity) const
+    file_comments& comments, type_safe::object_ref<const cppast::cpp_entity> entity) const
 {
-    auto unique_name
-        = get_full_unique_name(get_parent_unique_name(*entity), *entity, get_unique_name(*entity));
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    uncommented_.emplace(std::move(unique_name), &*entity);
+    auto parent = lookup_parent_unique_name([&](const cppast::cpp_entity&
+                                                    e) { return comments.registry.get_comment(e); },
+                                            *entity, comments.names);
+    comments.uncommented.emplace(get_full_unique_name(std::move(parent), *entity,
+                                                      get_unique_name(*entity)),
+                                 &*entity);
 }
 
-std::string file_comment_parser::get_parent_unique_name(const cppast::cpp_entity& e) const
+std::string standardese::lookup_unique_name(const comment_registry&   registry,
+                                            const cppast::cpp_entity& e)
 {
-    return lookup_parent_unique_name([&](const cppast::cpp_entity& e) { return get_comment(e); },
-                                     e);
+    unique_name_cache cache;
+    return lookup_unique_name(registry, e, cache);
 }
 
 std::string standardese::lookup_unique_name(const comment_registry&   registry,
-                                            const cppast::cpp_entity& e)
+                                            const cppast::cpp_entity& e, unique_name_cache& cache)
 {
+    auto get_comment = [&](const cppast::cpp_entity& e) { return registry.get_comment(e); };
+
     auto comment = registry.get_comment(e);
     if (comment && comment.value().metadata().unique_name())
     {
         if (is_relative_unique_name(comment.value().metadata().unique_name().value()))
         {
-            auto parent = lookup_parent_unique_name([&](const cppast::cpp_entity&
-                                                            e) { return registry.get_comment(e); },
-                                                    e);
-            return get_full_unique_name(parent, e,
+            auto parent = lookup_parent_unique_name(get_comment, e, cache);
+            return get_full_unique_name(std::move(parent), e,
                                         comment.value().metadata().unique_name().value().substr(1));
         }
         else
@@ -496,8 +598,6 @@ std::string standardese::lookup_unique_name(const comment_registry&   registry,
     }
 
     // calculate unique name
-    auto parent = lookup_parent_unique_name([&](const cppast::cpp_entity&
-                                                    e) { return registry.get_comment(e); },
-                                            e);
-    return get_full_unique_name(parent, e, get_unique_name(e));
+    auto parent = lookup_parent_unique_name(get_comment, e, cache);
+    return get_full_unique_name(std::move(parent), e, get_unique_name(e));
 }
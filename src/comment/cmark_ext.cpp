@@ -130,10 +130,17 @@ cmark_node* make_node(cmark_syntax_extension* self, cmark_parser* parser, cmark_
     return node;
 }
 
-cmark_node* make_node(cmark_syntax_extension* self, cmark_node_type node_type, unsigned raw_cmd,
-                      const char* arg)
+// cmark frees a tree with the allocator of its root,
+// so a new node must use the allocator of the tree it is inserted into
+cmark_node* new_node(cmark_node_type node_type, cmark_node* tree_node)
 {
-    auto node = cmark_node_new(node_type);
+    return cmark_node_new_with_mem(node_type, cmark_node_mem(tree_node));
+}
+
+cmark_node* make_node(cmark_syntax_extension* self, cmark_node* tree_node,
+                      cmark_node_type node_type, unsigned raw_cmd, const char* arg)
+{
+    auto node = new_node(node_type, tree_node);
     init_node(self, node, raw_cmd, arg);
     return node;
 }
@@ -157,18 +164,27 @@ void skip_whitespace(char*& cur)
         ++cur;
 }
 
+char* find_word_end(char* cur)
+{
+    while (*cur && !is_special_char(*cur) && !is_whitespace(*cur) && *cur != '-')
+        ++cur;
+    return cur;
+}
+
 std::string parse_word(char*& cur)
 {
     auto save = cur;
     skip_whitespace(cur);
 
-    std::string word;
-    for (; *cur && !is_special_char(*cur) && !is_whitespace(*cur) && *cur != '-'; ++cur)
-        word += *cur;
-
-    if (word.empty())
+    auto end = find_word_end(cur);
+    if (end == cur)
+    {
         cur = save;
+        return "";
+    }
 
+    std::string word(cur, end);
+    cur = end;
     return word;
 }
 
@@ -178,12 +194,15 @@ type_safe::optional<unsigned> try_parse_command(char*& cur, const config& c)
     {
         ++cur;
 
-        auto command = parse_word(cur);
-        if (command.empty())
+        auto begin = cur;
+        skip_whitespace(begin);
+        auto end = find_word_end(begin);
+        if (end == begin)
             // if command character was backslash, it was probably used to escape something
             return type_safe::nullopt;
-        else
-            return c.try_lookup(command.c_str());
+
+        cur = end;
+        return c.try_lookup(begin, std::size_t(end - begin));
     }
     else
         return type_safe::nullopt;
@@ -319,7 +338,7 @@ cmark_node* split_section(cmark_node* contents, bool implicit_brief)
     if (auto terminator = find_section_terminator(contents, implicit_brief))
     {
         // need to create a new node for the rest
-        auto paragraph = cmark_node_new(CMARK_NODE_PARAGRAPH);
+        auto paragraph = new_node(CMARK_NODE_PARAGRAPH, contents);
         cmark_node_insert_after(contents, paragraph);
 
         // add remaining nodes, after terminator
@@ -360,7 +379,8 @@ cmark_node* wrap_in_details(cmark_syntax_extension* self, cmark_node* first, cma
     if (!details)
     {
         // create new details section
-        details = make_node(self, node_section(), unsigned(section_type::details), nullptr);
+        details
+            = make_node(self, node, node_section(), unsigned(section_type::details), nullptr);
         // insert before current one
         cmark_node_insert_before(node, details);
     }
@@ -576,7 +596,8 @@ cmark_node* postprocess_nodes(cmark_syntax_extension* self, cmark_node* cur, Pre
         else if (need_brief.try_reset() && cmark_node_get_type(cur) == CMARK_NODE_PARAGRAPH)
         {
             // create an implicit brief section
-            auto brief = make_node(self, node_section(), unsigned(section_type::brief), nullptr);
+            auto brief
+                = make_node(self, cur, node_section(), unsigned(section_type::brief), nullptr);
             cmark_node_insert_before(cur, brief);
 
             // add contents to it
@@ -763,7 +784,7 @@ cmark_node* parse_verbatim(cmark_syntax_extension* self, cmark_parser*, cmark_no
 
         trim_spaces(content);
 
-        auto node = cmark_node_new(node_verbatim());
+        auto node = new_node(node_verbatim(), parent);
         cmark_node_set_string_content(node, content.c_str());
         cmark_node_set_syntax_extension(node, self);
         return node;
@@ -837,7 +858,7 @@ cmark_syntax_extension* standardese::comment::detail::create_no_html_extension()
                     else
                     {
                         // create new text and replace node
-                        text = cmark_node_new(CMARK_NODE_TEXT);
+                        text = new_node(CMARK_NODE_TEXT, node);
                         cmark_node_set_syntax_extension(text, self);
                         cmark_node_set_literal(text, cmark_node_get_literal(node));
 
@@ -4,6 +4,10 @@
 
 #include <standardese/comment/config.hpp>
 
+#include <cstring>
+
+#include <standardese/detail/hash.hpp>
+
 using namespace standardese::comment;
 
 const char* config::default_command_name(command_type cmd) noexcept
@@ -220,21 +224,26 @@ config::config(char command_character) : command_character_(command_character)
 
     for (auto i = 0u; i != unsigned(section_type::count); ++i)
         list_sections_[i] = default_list_section_name(make_section(i));
+
+    update_command_table();
 }
 
 void config::set_command_name(command_type cmd, std::string name)
 {
     command_names_[unsigned(cmd)] = std::move(name);
+    update_command_table();
 }
 
 void config::set_command_name(section_type cmd, std::string name)
 {
     command_names_[unsigned(cmd)] = std::move(name);
+    update_command_table();
 }
 
 void config::set_command_name(inline_type cmd, std::string name)
 {
     command_names_[unsigned(cmd)] = std::move(name);
+    update_command_table();
 }
 
 const char* config::command_name(command_type cmd) const noexcept
@@ -252,17 +261,52 @@ const char* config::command_name(inline_type cmd) const noexcept
     return command_names_[unsigned(cmd)].c_str();
 }
 
-unsigned config::try_lookup(const char* name) const noexcept
+void config::update_command_table() noexcept
 {
-    auto i = 0u;
-    for (auto& el : command_names_)
+    static_assert(unsigned(inline_type::count) < 255u, "index + 1 must fit into a byte");
+    static_assert(2u * unsigned(inline_type::count) <= sizeof(command_table_),
+                  "command table too small");
+
+    command_table_.fill(0u);
+
+    for (auto i = 0u; i != command_names_.size(); ++i)
     {
-        if (el == name)
-            return i;
-        ++i;
+        auto& name = command_names_[i];
+        if (name.empty())
+            // unused index
+            continue;
+
+        auto matches = [&](std::size_t s) {
+            return command_table_[s] == 0u || command_names_[command_table_[s] - 1u] == name;
+        };
+
+        auto hash = standardese::detail::hash_string(name.data(), name.size());
+        auto slot = standardese::detail::probe_slot(hash, command_table_.size(), matches);
+        if (command_table_[slot] == 0u)
+            // first command with that name wins
+            command_table_[slot] = std::uint8_t(i + 1u);
     }
+}
+
+unsigned config::try_lookup(const char* name) const noexcept
+{
+    return try_lookup(name, std::strlen(name));
+}
 
-    return unsigned(command_type::invalid);
+unsigned config::try_lookup(const char* name, std::size_t size) const noexcept
+{
+    auto matches = [&](std::size_t s) {
+        if (command_table_[s] == 0u)
+            return true;
+        auto& command = command_names_[command_table_[s] - 1u];
+        return command.size() == size && std::memcmp(command.data(), name, size) == 0;
+    };
+
+    auto hash = standardese::detail::hash_string(name, size);
+    auto slot = standardese::detail::probe_slot(hash, command_table_.size(), matches);
+    if (command_table_[slot] == 0u)
+        return unsigned(command_type::invalid);
+    return command_table_[slot] - 1u;
 }
 
 const char* config::inline_section_name(section_type section) const noexcept
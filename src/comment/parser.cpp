@@ -20,13 +20,16 @@
 #include <standardese/markup/quote.hpp>
 #include <standardese/markup/thematic_break.hpp>
 
+#include "../detail/cmark_allocator.hpp"
 #include "cmark_ext.hpp"
 
 using namespace standardese;
 using namespace standardese::comment;
 
 parser::parser(comment::config c)
-: config_(std::move(c)), parser_(cmark_parser_new(CMARK_OPT_SMART))
+: config_(std::move(c)),
+  parser_(cmark_parser_new_with_mem(CMARK_OPT_SMART,
+                                    standardese::detail::get_cmark_pool_allocator()))
 {
     auto command_ext = detail::create_command_extension(config_);
     cmark_parser_attach_syntax_extension(parser_, command_ext);
@@ -790,10 +793,113 @@ void add_children(const config& c, Builder& b, bool has_matching_entity, cmark_n
             }
     }
 }
+
+//=== fast path ===//
+// Most comments are a single sentence, optionally starting with a section command.
+// If such a line doesn't contain anything CommonMark (or smart punctuation) could interpret,
+// the result is known without invoking cmark.
+bool is_ascii_alpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool is_plain_char(char c)
+{
+    return is_ascii_alpha(c) || (c >= '0' && c <= '9') || (c & 0x80) != 0 || c == ' '
+           || (c != '\0' && std::strchr(",.;:?()/%=+", c) != nullptr);
+}
+
+// returns the trimmed text or nullptr if it isn't plain
+const char* get_plain_text(const config& c, const char* begin, const char*& end)
+{
+    auto no_spaces = 0;
+    for (; begin != end && *begin == ' '; ++begin)
+        ++no_spaces;
+    if (no_spaces >= 4 || begin == end || !is_ascii_alpha(*begin))
+        // indented code, empty or possibly a block
+        return nullptr;
+
+    while (end[-1] == ' ')
+        --end;
+
+    for (auto cur = begin; cur != end; ++cur)
+        if (!is_plain_char(*cur) || *cur == c.command_character()
+            || (*cur == '.' && cur + 1 != end && cur[1] == '.'))
+            return nullptr;
+
+    return begin;
+}
+
+bool is_command_word_char(char c)
+{
+    // same as parse_word() in cmark_ext.cpp
+    return !std::strchr(R"(!\"#$%&'()*+,-./:;<=>?@\^`{|}~)", c) && c != ' ' && c != '\t'
+           && c != '\n';
+}
+
+type_safe::optional<parse_result> try_parse_trivial(const config& c, const std::string& comment)
+{
+    if (comment.find('\n') != std::string::npos)
+        return type_safe::nullopt;
+
+    auto begin = comment.c_str();
+    auto end   = begin + comment.size();
+
+    std::unique_ptr<markup::brief_section>            brief;
+    std::vector<std::unique_ptr<markup::doc_section>> sections;
+    if (*begin == c.command_character())
+    {
+        // \section text
+        auto name_begin = begin + 1;
+        auto name_end   = name_begin;
+        while (name_end != end && is_command_word_char(*name_end))
+            ++name_end;
+        if (name_end == name_begin || name_end == end || *name_end != ' ')
+            return type_safe::nullopt;
+
+        auto command = c.try_lookup(name_begin, std::size_t(name_end - name_begin));
+        if (!is_section(command) || make_section(command) == section_type::details)
+            return type_safe::nullopt;
+
+        // no '-' in the text, so it can't be a key-value section
+        auto text = get_plain_text(c, name_end, end);
+        if (!text)
+            return type_safe::nullopt;
+
+        auto type = make_section(command);
+        if (type == section_type::brief)
+        {
+            markup::brief_section::builder builder;
+            builder.add_child(markup::text::build(std::string(text, end)));
+            brief = builder.finish();
+        }
+        else
+        {
+            markup::inline_section::builder builder(type, c.inline_section_name(type));
+            builder.add_child(markup::text::build(std::string(text, end)));
+            sections.push_back(builder.finish());
+        }
+    }
+    else if (auto text = get_plain_text(c, begin, end))
+    {
+        // implicit brief
+        markup::brief_section::builder builder;
+        builder.add_child(markup::text::build(std::string(text, end)));
+        brief = builder.finish();
+    }
+    else
+        return type_safe::nullopt;
+
+    return parse_result{doc_comment(metadata(), std::move(brief), std::move(sections)),
+                        matching_entity(), {}};
+}
 } // namespace
 
 parse_result comment::parse(const parser& p, const std::string& comment, bool has_matching_entity)
 {
+    if (auto trivial = try_parse_trivial(p.config(), comment))
+        return std::move(trivial.value());
+
     auto root = read_ast(p, comment);
 
     comment_builder builder;
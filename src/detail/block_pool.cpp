@@ -0,0 +1,263 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "block_pool.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+using namespace standardese;
+
+namespace
+{
+constexpr std::size_t block_granularity = 16u;
+constexpr std::size_t no_size_classes   = 16u; // blocks up to 256 bytes
+constexpr std::size_t chunk_size        = 64u * 1024u;
+
+class block_pool;
+
+struct block_header
+{
+    block_pool* owner; // nullptr if allocated with malloc()
+    std::size_t size_class;
+};
+
+// the header is padded, so the memory after it is aligned for any type
+constexpr std::size_t header_size = block_granularity;
+static_assert(sizeof(block_header) <= header_size, "block header too big");
+
+// a free block must have room for the free list pointer, so size 0 uses the smallest class as well
+constexpr std::size_t get_size_class(std::size_t size) noexcept
+{
+    return size == 0u ? 0u : (size - 1u) / block_granularity;
+}
+
+constexpr std::size_t get_capacity(std::size_t size_class) noexcept
+{
+    return (size_class + 1u) * block_granularity;
+}
+
+block_header* get_header(void* ptr) noexcept
+{
+    return reinterpret_cast<block_header*>(static_cast<char*>(ptr) - header_size);
+}
+
+void* get_memory(block_header* header) noexcept
+{
+    return reinterpret_cast<char*>(header) + header_size;
+}
+
+// the memory of a free block stores the next block in the free list
+block_header*& next_free(block_header* header) noexcept
+{
+    return *static_cast<block_header**>(get_memory(header));
+}
+
+class block_pool
+{
+public:
+    block_pool() noexcept
+    : remote_free_list_(nullptr), state_(0u), chunks_(nullptr), cur_(nullptr), end_(nullptr)
+    {}
+
+    ~block_pool() noexcept
+    {
+        while (chunks_)
+        {
+            auto next = *reinterpret_cast<char**>(chunks_);
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+    }
+
+    // only called by the owning thread
+    void* allocate(std::size_t size_class) noexcept
+    {
+        if (!free_lists_[size_class] && remote_free_list_.load(std::memory_order_relaxed))
+            take_remote_blocks();
+
+        auto block = free_lists_[size_class];
+        if (block)
+            free_lists_[size_class] = next_free(block);
+        else
+        {
+            auto size = header_size + get_capacity(size_class);
+            if (cur_ == nullptr || size > static_cast<std::size_t>(end_ - cur_))
+            {
+                // the rest of the old chunk is wasted
+                auto chunk = static_cast<char*>(::operator new(chunk_size, std::nothrow));
+                if (!chunk)
+                    return nullptr;
+
+                // the first bytes of a chunk link it to the previous one
+                *reinterpret_cast<char**>(chunk) = chunks_;
+                chunks_                          = chunk;
+                cur_                             = chunk + block_granularity;
+                end_                             = chunk + chunk_size;
+            }
+
+            block = reinterpret_cast<block_header*>(cur_);
+            cur_ += size;
+            block->owner      = this;
+            block->size_class = size_class;
+        }
+
+        state_.fetch_add(1u, std::memory_order_relaxed);
+        return get_memory(block);
+    }
+
+    // only called by the owning thread
+    void deallocate(block_header* block) noexcept
+    {
+        next_free(block)                = free_lists_[block->size_class];
+        free_lists_[block->size_class] = block;
+        state_.fetch_sub(1u, std::memory_order_relaxed);
+    }
+
+    // called by any other thread, destroys the pool if it was the last block of an abandoned pool
+    static void deallocate_remote(block_header* block) noexcept
+    {
+        auto pool = block->owner;
+
+        auto head = pool->remote_free_list_.load(std::memory_order_relaxed);
+        do
+            next_free(block) = head;
+        while (!pool->remote_free_list_.compare_exchange_weak(head, block,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed));
+
+        if (pool->state_.fetch_sub(1u, std::memory_order_acq_rel) == (abandoned | 1u))
+            delete pool;
+    }
+
+    // called by the owning thread when it exits,
+    // destroys the pool if all blocks have been freed already,
+    // otherwise the last deallocate_remote() will do so
+    static void abandon(block_pool* pool) noexcept
+    {
+        if (pool->state_.fetch_or(abandoned, std::memory_order_acq_rel) == 0u)
+            delete pool;
+    }
+
+private:
+    void take_remote_blocks() noexcept
+    {
+        auto block = remote_free_list_.exchange(nullptr, std::memory_order_acquire);
+        while (block)
+        {
+            auto next                      = next_free(block);
+            next_free(block)               = free_lists_[block->size_class];
+            free_lists_[block->size_class] = block;
+            block                          = next;
+        }
+    }
+
+    static constexpr std::size_t abandoned = std::size_t(1u)
+                                             << (std::numeric_limits<std::size_t>::digits - 1);
+
+    std::atomic<block_header*> remote_free_list_;
+    // the number of allocated blocks, the highest bit is set once the thread exited
+    std::atomic<std::size_t> state_;
+
+    block_header* free_lists_[no_size_classes] = {};
+    char*         chunks_;
+    char*         cur_;
+    char*         end_;
+};
+
+constexpr std::size_t block_pool::abandoned;
+
+thread_local block_pool* current_pool  = nullptr;
+thread_local bool        thread_exited = false;
+
+struct pool_owner
+{
+    block_pool* pool;
+
+    pool_owner() noexcept : pool(new (std::nothrow) block_pool) {}
+
+    ~pool_owner() noexcept
+    {
+        // blocks freed while the remaining thread local objects are destroyed
+        // are treated like blocks freed by another thread
+        current_pool  = nullptr;
+        thread_exited = true;
+        if (pool)
+            block_pool::abandon(pool);
+    }
+};
+
+block_pool* get_pool() noexcept
+{
+    if (!current_pool && !thread_exited)
+    {
+        static thread_local pool_owner owner;
+        current_pool = owner.pool;
+    }
+    return current_pool;
+}
+} // namespace
+
+void* detail::pool_allocate(std::size_t size) noexcept
+{
+    auto size_class = get_size_class(size);
+    if (size_class < no_size_classes)
+        if (auto pool = get_pool())
+            return pool->allocate(size_class);
+
+    // big block, or the thread doesn't have a pool
+    if (size > std::numeric_limits<std::size_t>::max() - header_size)
+        return nullptr;
+    auto header = static_cast<block_header*>(std::malloc(size + header_size));
+    if (!header)
+        return nullptr;
+    header->owner      = nullptr;
+    header->size_class = no_size_classes;
+    return get_memory(header);
+}
+
+void detail::pool_deallocate(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    auto header = get_header(ptr);
+    if (!header->owner)
+        std::free(header);
+    else if (header->owner == current_pool)
+        header->owner->deallocate(header);
+    else
+        block_pool::deallocate_remote(header);
+}
+
+void* detail::pool_reallocate(void* ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return pool_allocate(size);
+
+    auto header = get_header(ptr);
+    if (!header->owner)
+    {
+        // once big, the block stays a malloc() block
+        if (size > std::numeric_limits<std::size_t>::max() - header_size)
+            return nullptr;
+        auto new_header = static_cast<block_header*>(std::realloc(header, size + header_size));
+        return new_header ? get_memory(new_header) : nullptr;
+    }
+
+    auto capacity = get_capacity(header->size_class);
+    if (size <= capacity)
+        return ptr;
+
+    auto result = pool_allocate(size);
+    if (result)
+    {
+        std::memcpy(result, ptr, capacity);
+        pool_deallocate(ptr);
+    }
+    return result;
+}
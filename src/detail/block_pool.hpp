@@ -0,0 +1,36 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_DETAIL_BLOCK_POOL_HPP_INCLUDED
+#define STANDARDESE_DETAIL_BLOCK_POOL_HPP_INCLUDED
+
+#include <cstddef>
+
+namespace standardese
+{
+namespace detail
+{
+    // Allocation of many small blocks of memory.
+    //
+    // Every thread has its own pool with a free list for each size class,
+    // refilled by bump allocation out of big chunks.
+    // Each block stores the pool it belongs to,
+    // so a block freed by a different thread is handed back to that pool and reused there.
+    // The chunks of a pool are released after its thread has exited
+    // and all of its blocks have been freed.
+    // Bigger blocks are allocated with malloc().
+
+    // returns a block of at least the given size aligned for any type,
+    // or nullptr if out of memory
+    void* pool_allocate(std::size_t size) noexcept;
+
+    // requires: ptr is nullptr or was returned by one of the pool functions
+    void pool_deallocate(void* ptr) noexcept;
+
+    // same as realloc(), returns nullptr if out of memory, ptr is still valid then
+    void* pool_reallocate(void* ptr, std::size_t size) noexcept;
+} // namespace detail
+} // namespace standardese
+
+#endif // STANDARDESE_DETAIL_BLOCK_POOL_HPP_INCLUDED
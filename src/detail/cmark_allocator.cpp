@@ -0,0 +1,49 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "cmark_allocator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "block_pool.hpp"
+
+using namespace standardese;
+
+namespace
+{
+// same as the default allocator of cmark, out of memory is fatal
+void* pool_calloc(std::size_t count, std::size_t size)
+{
+    if (size != 0u && count > std::numeric_limits<std::size_t>::max() / size)
+        std::abort();
+
+    auto ptr = detail::pool_allocate(count * size);
+    if (!ptr)
+        std::abort();
+    std::memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* pool_realloc(void* ptr, std::size_t size)
+{
+    auto result = detail::pool_reallocate(ptr, size);
+    if (!result)
+        std::abort();
+    return result;
+}
+
+void pool_free(void* ptr)
+{
+    detail::pool_deallocate(ptr);
+}
+
+cmark_mem pool_allocator = {pool_calloc, pool_realloc, pool_free};
+} // namespace
+
+cmark_mem* detail::get_cmark_pool_allocator() noexcept
+{
+    return &pool_allocator;
+}
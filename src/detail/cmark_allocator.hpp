@@ -0,0 +1,22 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_DETAIL_CMARK_ALLOCATOR_HPP_INCLUDED
+#define STANDARDESE_DETAIL_CMARK_ALLOCATOR_HPP_INCLUDED
+
+#include <cmark-gfm.h>
+
+namespace standardese
+{
+namespace detail
+{
+    // cmark allocator that uses the block pool,
+    // cmark allocates and frees the nodes of every comment one by one.
+    // All nodes of one tree must use the same allocator,
+    // as cmark frees a tree with the allocator of its root.
+    cmark_mem* get_cmark_pool_allocator() noexcept;
+} // namespace detail
+} // namespace standardese
+
+#endif // STANDARDESE_DETAIL_CMARK_ALLOCATOR_HPP_INCLUDED
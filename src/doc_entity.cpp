@@ -797,7 +797,8 @@ std::unique_ptr<markup::documentation_entity> doc_cpp_entity::do_generate_docume
     auto inline_doc
         = gen_config.is_flag_set(generation_config::inline_doc) && empty_sections(comment());
 
-    if (group_member_no_.value_or(1u) != 1u || get_documentation_id().as_str() != link_name())
+    if (group_member_no_.value_or(1u) != 1u
+        || get_documentation_id() != markup::block_id(interned_link_name()))
         // not a main entity that needs documentation
         return nullptr;
     // various inline entities
@@ -1176,6 +1177,7 @@ bool is_ignored(const cppast::cpp_entity& e)
 
 std::unique_ptr<doc_entity> build_entity(const comment_registry&         registry,
                                          const cppast::cpp_entity_index& index,
+                                         unique_name_cache&              names,
                                          const cppast::cpp_entity&       e);
 
 type_safe::optional_ref<const cppast::cpp_class> is_excluded_base(
@@ -1229,13 +1231,14 @@ void handle_bases(const Visitor& visitor, const comment_registry& registry,
 
 std::unique_ptr<doc_cpp_entity> build_cpp_entity(const comment_registry&         registry,
                                                  const cppast::cpp_entity_index& index,
+                                                 unique_name_cache&              names,
                                                  const cppast::cpp_entity&       e)
 {
-    auto                    link_name = lookup_unique_name(registry, e);
+    auto                    link_name = lookup_unique_name(registry, e, names);
     doc_cpp_entity::builder builder(link_name, type_safe::ref(e), registry.get_comment(e));
 
     auto visitor = [&](const cppast::cpp_entity& entity, bool injected) {
-        if (auto child = build_entity(registry, index, entity))
+        if (auto child = build_entity(registry, index, names, entity))
         {
             if (injected)
                 child->mark_injected();
@@ -1263,6 +1266,7 @@ std::unique_ptr<doc_cpp_entity> build_cpp_entity(const comment_registry&
 
 std::unique_ptr<doc_metadata_entity> build_metadata_entity(const comment_registry&         registry,
                                                            const cppast::cpp_entity_index& index,
+                                                           unique_name_cache&              names,
                                                            const cppast::cpp_entity&       e)
 {
     auto comment = registry.get_comment(e);
@@ -1271,7 +1275,7 @@ std::unique_ptr<doc_metadata_entity> build_metadata_entity(const comment_registr
 
     doc_metadata_entity::builder builder(type_safe::ref(e), type_safe::ref(comment.value()));
     detail::visit_children(e, [&](const cppast::cpp_entity& entity) {
-        if (auto child = build_entity(registry, index, entity))
+        if (auto child = build_entity(registry, index, names, entity))
             builder.add_child(std::move(child));
     });
     return builder.finish();
@@ -1279,6 +1283,7 @@ std::unique_ptr<doc_metadata_entity> build_metadata_entity(const comment_registr
 
 std::unique_ptr<doc_member_group_entity> build_member_group(const comment_registry& registry,
                                                             const cppast::cpp_entity_index& index,
+                                                            unique_name_cache&        names,
                                                             const std::string&        group_name,
                                                             const cppast::cpp_entity& e)
 {
@@ -1301,20 +1306,21 @@ std::unique_ptr<doc_member_group_entity> build_member_group(const comment_regist
         // e is the main entity, so build group
         doc_member_group_entity::builder builder(group_name);
         for (auto& member : group)
-            builder.add_member(build_cpp_entity(registry, index, *member));
+            builder.add_member(build_cpp_entity(registry, index, names, *member));
         return builder.finish();
     }
 }
 
 std::unique_ptr<doc_cpp_namespace> build_namespace(const comment_registry&         registry,
                                                    const cppast::cpp_entity_index& index,
+                                                   unique_name_cache&              names,
                                                    const cppast::cpp_namespace&    ns)
 {
-    doc_cpp_namespace::builder builder(lookup_unique_name(registry, ns), type_safe::ref(ns),
+    doc_cpp_namespace::builder builder(lookup_unique_name(registry, ns, names), type_safe::ref(ns),
                                        registry.get_comment(ns));
 
     detail::visit_children(ns, [&](const cppast::cpp_entity& entity) {
-        if (auto child = build_entity(registry, index, entity))
+        if (auto child = build_entity(registry, index, names, entity))
             builder.add_child(std::move(child));
     });
 
@@ -1349,6 +1355,7 @@ bool build_is_excluded(const cppast::cpp_entity_index& index, const cppast::cpp_
 
 std::unique_ptr<doc_entity> build_entity(const comment_registry&         registry,
                                          const cppast::cpp_entity_index& index,
+                                         unique_name_cache&              names,
                                          const cppast::cpp_entity&       e)
 {
     auto comment = registry.get_comment(e);
@@ -1356,14 +1363,15 @@ std::unique_ptr<doc_entity> build_entity(const comment_registry&         registr
         return nullptr;
     else if (is_ignored(e) || (e.kind() == cppast::cpp_friend::kind() && !is_friend_func_def(e)))
         // those can only be documented as metadata
-        return build_metadata_entity(registry, index, e);
+        return build_metadata_entity(registry, index, names, e);
     else if (e.kind() == cppast::cpp_namespace::kind())
-        return build_namespace(registry, index, static_cast<const cppast::cpp_namespace&>(e));
+        return build_namespace(registry, index, names,
+                               static_cast<const cppast::cpp_namespace&>(e));
     else if (comment.has_value() && comment.value().metadata().group())
-        return build_member_group(registry, index,
+        return build_member_group(registry, index, names,
                                   comment.value().metadata().group().value().name(), e);
     else
-        return build_cpp_entity(registry, index, e);
+        return build_cpp_entity(registry, index, names, e);
 }
 } // namespace
 
@@ -1413,11 +1421,12 @@ std::unique_ptr<doc_cpp_file> standardese::build_doc_entities(
     if (comment && comment.value().metadata().output_name())
         output_name = comment.value().metadata().output_name().value();
 
-    doc_cpp_file::builder builder(std::move(output_name), lookup_unique_name(*registry, f),
+    unique_name_cache     names;
+    doc_cpp_file::builder builder(std::move(output_name), lookup_unique_name(*registry, f, names),
                                   std::move(file), comment);
 
     detail::visit_children(f, [&](const cppast::cpp_entity& entity) {
-        if (auto child = build_entity(*registry, index, entity))
+        if (auto child = build_entity(*registry, index, names, entity))
             builder.add_child(std::move(child));
     });
 
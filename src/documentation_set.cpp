@@ -0,0 +1,108 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/documentation_set.hpp>
+
+using namespace standardese;
+
+constexpr std::size_t documentation_set::default_cache_size;
+
+documentation_set::documentation_set(
+    std::vector<std::unique_ptr<doc_cpp_file>>             files,
+    std::vector<std::unique_ptr<markup::document_entity>> documents, std::unique_ptr<linker> l,
+    type_safe::object_ref<const cppast::diagnostic_logger> logger, std::size_t cache_size)
+: files_(std::move(files)), linker_(std::move(l)), logger_(logger), cached_size_(0u),
+  max_cached_size_(cache_size)
+{
+    linker_->freeze();
+
+    documents_.reserve(documents.size());
+    for (auto& doc : documents)
+    {
+        auto name = doc->output_name().name();
+        documents_.emplace(std::move(name),
+                           std::unique_ptr<document>(new document(std::move(doc))));
+    }
+}
+
+void documentation_set::add_format(std::string name, markup::generator generator)
+{
+    formats_[std::move(name)] = std::move(generator);
+}
+
+type_safe::optional_ref<const markup::document_entity> documentation_set::lookup(
+    const std::string& output_name) const
+{
+    auto iter = documents_.find(output_name);
+    if (iter == documents_.end())
+        return nullptr;
+    return type_safe::ref(get_resolved(*iter->second));
+}
+
+std::shared_ptr<const std::string> documentation_set::render(const std::string& output_name,
+                                                             const std::string& format) const
+{
+    auto doc = documents_.find(output_name);
+    auto gen = formats_.find(format);
+    if (doc == documents_.end() || gen == formats_.end())
+        return nullptr;
+
+    auto key = output_name;
+    key += '\0';
+    key += format;
+    if (auto cached = get_cached(key))
+        return cached;
+
+    // rendered outside of the lock, so different documents can be rendered in parallel,
+    // the same document might be rendered twice, but the result is the same
+    auto& entity = get_resolved(*doc->second);
+
+    auto output = std::make_shared<std::string>();
+    markup::render(gen->second, entity, *output);
+
+    insert_cached(std::move(key), output);
+    return output;
+}
+
+const markup::document_entity& documentation_set::get_resolved(document& doc) const
+{
+    // the links are resolved by the first thread that needs the document,
+    // all others wait until it is done
+    std::call_once(doc.resolved, [&] { resolve_links(*logger_, *linker_, *doc.entity); });
+    return *doc.entity;
+}
+
+std::shared_ptr<const std::string> documentation_set::get_cached(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+
+    auto iter = cache_.find(key);
+    if (iter == cache_.end())
+        return nullptr;
+
+    // mark as most recently used
+    cache_list_.splice(cache_list_.begin(), cache_list_, iter->second);
+    return iter->second->second;
+}
+
+void documentation_set::insert_cached(std::string                        key,
+                                      std::shared_ptr<const std::string> output) const
+{
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (output->size() > max_cached_size_ || cache_.count(key) != 0u)
+        // too big or already rendered by another thread
+        return;
+
+    cached_size_ += output->size();
+    cache_list_.emplace_front(key, std::move(output));
+    cache_.emplace(std::move(key), cache_list_.begin());
+
+    while (cached_size_ > max_cached_size_)
+    {
+        auto& last = cache_list_.back();
+        cached_size_ -= last.second->size();
+        cache_.erase(last.first);
+        cache_list_.pop_back();
+    }
+}
@@ -6,6 +6,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iterator>
+#include <thread>
+
 #include <cppast/cpp_file.hpp>
 #include <cppast/cpp_namespace.hpp>
 #include <cppast/cpp_preprocessor.hpp>
@@ -22,29 +26,17 @@
 
 using namespace standardese;
 
+constexpr std::size_t entity_index::no_buffers;
+
 void entity_index::insert(entity e) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto                        range
-        = std::equal_range(entities_.begin(), entities_.end(), e,
-                           [](const entity_index::entity& lhs, const entity_index::entity& rhs) {
-                               return lhs.scope + lhs.name < rhs.scope + rhs.name;
-                           });
-    if (range.first == range.second)
-        entities_.insert(range.first, std::move(e));
-    else
-    {
-        assert(std::next(range.first) == range.second);
-        auto& inserted = *range.first;
-        if (auto builder = inserted.doc.optional_value(
-                type_safe::variant_type<markup::namespace_documentation::builder>{}))
-        {
-            auto& e_builder
-                = e.doc.value(type_safe::variant_type<markup::namespace_documentation::builder>{});
-            if (!builder.value().has_documentation() && e_builder.has_documentation())
-                inserted.doc = std::move(e.doc);
-        }
-    }
+    // the buffers don't keep the order of the registrations
+    e.sequence = next_sequence_.fetch_add(1u, std::memory_order_relaxed);
+
+    auto& buffer = buffers_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % no_buffers];
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.entities.push_back(std::move(e));
 }
 
 namespace
@@ -157,14 +149,51 @@ std::unique_ptr<markup::entity_index> entity_index::generate(order o) const
     markup::entity_index::builder builder(
         markup::heading::build(markup::block_id(), "Project index"));
 
+    std::vector<entity> entities;
+    for (auto& buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        std::move(buffer.entities.begin(), buffer.entities.end(), std::back_inserter(entities));
+        buffer.entities.clear();
+    }
+    std::sort(entities.begin(), entities.end(), [](const entity& lhs, const entity& rhs) {
+        auto result = lhs.key.compare(rhs.key);
+        return result < 0 || (result == 0 && lhs.sequence < rhs.sequence);
+    });
+
+    // whether the entity is a direct child of the namespace with the given key
+    auto is_in_scope = [](const entity& e, const std::string& ns_key) {
+        if (ns_key.empty())
+            return e.scope_size == 0u;
+        else
+            // scope is the namespace key followed by "::"
+            return e.scope_size == ns_key.size() + 2u
+                   && e.key.compare(0, ns_key.size(), ns_key) == 0;
+    };
+
     std::vector<nested_list_builder> lists;
     lists.push_back(nested_list_builder{"", type_safe::ref(builder)});
 
-    std::unique_lock<std::mutex> lock(mutex_);
-    for (auto& entity : entities_)
+    for (auto iter = entities.begin(); iter != entities.end();)
     {
+        auto& entity = *iter;
+
+        // handle duplicates: keep the first one,
+        // but a namespace prefers one that is documented
+        auto next = std::next(iter);
+        for (; next != entities.end() && next->key == entity.key; ++next)
+        {
+            auto builder = entity.doc.optional_value(
+                type_safe::variant_type<markup::namespace_documentation::builder>{});
+            auto next_builder = next->doc.optional_value(
+                type_safe::variant_type<markup::namespace_documentation::builder>{});
+            if (builder && next_builder && !builder.value().has_documentation()
+                && next_builder.value().has_documentation())
+                entity.doc = std::move(next->doc);
+        }
+
         // find matching parent
-        while (entity.scope != (lists.back().scope.empty() ? "" : lists.back().scope + "::"))
+        while (!is_in_scope(entity, lists.back().scope))
         {
             auto ns = std::move(lists.back());
             lists.pop_back();
@@ -174,13 +203,14 @@ std::unique_ptr<markup::entity_index> entity_index::generate(order o) const
         if (auto ns = entity.doc.optional_value(
                 type_safe::variant_type<markup::namespace_documentation::builder>{}))
             // we've got a namespace
-            lists.push_back(nested_list_builder{entity.scope + entity.name, std::move(ns.value())});
+            lists.push_back(nested_list_builder{entity.key, std::move(ns.value())});
         else
             // normal entity
             lists.back().add_item(std::move(entity.doc.value(
                 type_safe::variant_type<std::unique_ptr<markup::entity_index_item>>{})));
+
+        iter = next;
     }
-    lock.unlock();
 
     while (!lists.empty())
     {
@@ -0,0 +1,63 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/interned_string.hpp>
+
+#include <array>
+#include <limits>
+#include <mutex>
+#include <unordered_set>
+
+using namespace standardese;
+
+namespace
+{
+// the strings are distributed over multiple independently locked sets,
+// the elements of the node-based sets never move
+class string_pool
+{
+public:
+    const std::string* intern(const std::string& str)
+    {
+        auto hash = std::hash<std::string>{}(str);
+        // use the high bits, the low bits select the bucket inside the set
+        auto& shard = shards_[(hash >> (std::numeric_limits<std::size_t>::digits - 4)) % no_shards];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return &*shard.strings.insert(str).first;
+    }
+
+private:
+    struct shard
+    {
+        std::mutex                      mutex;
+        std::unordered_set<std::string> strings;
+    };
+
+    static constexpr std::size_t no_shards = 16u;
+
+    std::array<shard, no_shards> shards_;
+};
+
+constexpr std::size_t string_pool::no_shards;
+
+string_pool& get_pool()
+{
+    // never destroyed, so strings stay valid during static destruction
+    static auto pool = new string_pool;
+    return *pool;
+}
+
+const std::string* get_empty_string()
+{
+    static const std::string empty;
+    return &empty;
+}
+} // namespace
+
+interned_string::interned_string() noexcept : str_(get_empty_string()) {}
+
+interned_string::interned_string(const std::string& str)
+: str_(str.empty() ? get_empty_string() : get_pool().intern(str))
+{}
@@ -6,12 +6,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iterator>
+#include <limits>
 
 #include <cppast/cpp_entity.hpp>
 #include <cppast/cpp_file.hpp>
 #include <cppast/cpp_namespace.hpp>
 #include <cppast/visitor.hpp>
 
+#include <standardese/detail/hash.hpp>
 #include <standardese/doc_entity.hpp>
 #include <standardese/logger.hpp>
 #include <standardese/markup/document.hpp>
@@ -97,43 +101,131 @@ std::string short_link_name(const std::string& name)
 }
 } // namespace
 
+constexpr std::size_t linker::no_shards;
+
+linker::shard& linker::get_shard(const std::string& link_name) const noexcept
+{
+    // use the high bits, the low bits select the bucket inside the map
+    auto hash = std::hash<std::string>{}(link_name);
+    return shards_[(hash >> (std::numeric_limits<std::size_t>::digits - 5)) % no_shards];
+}
+
 bool linker::register_documentation(std::string link_name, const markup::document_entity& document,
                                     const markup::block_id& documentation, bool force) const
 {
+    if (frozen_)
+        throw std::logic_error("cannot register documentation '" + link_name
+                               + "' after the linker has been frozen");
     auto ref = markup::block_reference(document.output_name(), documentation);
 
     link_name       = process_link_name(std::move(link_name));
     auto short_name = short_link_name(link_name);
-
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto has_short  = short_name != link_name;
 
     // insert long name
-    auto result = map_.emplace(std::move(link_name), ref);
-    if (!result.second) // not inserted
     {
-        if (force)
-            result.first->second = ref; // override anyway
-        else
-            return false;
+        auto&                       shard = get_shard(link_name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto result = shard.map.emplace(std::move(link_name), ref);
+        if (!result.second) // not inserted
+        {
+            if (force)
+                result.first->second = ref; // override anyway
+            else
+                return false;
+        }
     }
 
     // insert short name
-    if (short_name != result.first->first)
+    if (has_short)
     {
-        result = map_.emplace(std::move(short_name), ref);
+        auto&                       shard = get_shard(short_name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto result = shard.map.emplace(std::move(short_name), ref);
         if (!result.second)
         {
             if (force)
                 result.first->second = std::move(ref);
             else
                 // duplicate, erase first one as well
-                map_.erase(result.first);
+                shard.map.erase(result.first);
         }
     }
 
     return true;
 }
 
+namespace
+{
+// independent from the hash of the shards
+std::uint64_t hash_link_name(const std::string& link_name) noexcept
+{
+    return detail::hash_string(link_name.data(), link_name.size());
+}
+} // namespace
+
+void linker::freeze() const
+{
+    if (frozen_)
+        // the shards are already empty
+        return;
+
+    auto no_entries = std::size_t(0u);
+    for (auto& shard : shards_)
+        no_entries += shard.map.size();
+
+    // power of two with a load factor of at most one half
+    auto table_size = std::size_t(2u);
+    while (table_size < 2u * no_entries)
+        table_size *= 2u;
+
+    frozen_entries_.reserve(no_entries);
+    frozen_table_.assign(table_size, 0u);
+    for (auto& shard : shards_)
+    {
+        for (auto& entry : shard.map)
+        {
+            frozen_entries_.push_back(frozen_entry{entry.first, std::move(entry.second)});
+
+            auto slot = detail::probe_slot(hash_link_name(entry.first), table_size,
+                                           [&](std::size_t i) { return frozen_table_[i] == 0u; });
+            frozen_table_[slot] = static_cast<std::uint32_t>(frozen_entries_.size());
+        }
+
+        // free the memory of the map
+        decltype(shard.map)().swap(shard.map);
+    }
+
+    frozen_ = true;
+}
+
+type_safe::optional<markup::block_reference> linker::lookup(const std::string& link_name) const
+{
+    if (frozen_)
+    {
+        auto matches = [&](std::size_t i) {
+            return frozen_table_[i] == 0u
+                   || frozen_entries_[frozen_table_[i] - 1u].link_name == link_name;
+        };
+
+        auto slot = detail::probe_slot(hash_link_name(link_name), frozen_table_.size(), matches);
+        if (frozen_table_[slot] == 0u)
+            return type_safe::nullopt;
+        return frozen_entries_[frozen_table_[slot] - 1u].reference;
+    }
+    else
+    {
+        auto&                       shard = get_shard(link_name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto                        iter = shard.map.find(link_name);
+        if (iter == shard.map.end())
+            return type_safe::nullopt;
+        return iter->second;
+    }
+}
+
 namespace
 {
 bool has_scope(const std::string& str, const std::string& scope)
@@ -157,23 +249,31 @@ markup::url get_url(const std::string& url, const std::string& link_name)
     return markup::url(result);
 }
 
-std::string get_scope_name(const cppast::cpp_entity& entity)
+// stores the scope of the entity, i.e. the scope names of all parents,
+// the scope of each parent is a prefix of it, their lengths are stored as well,
+// starting with the empty scope of the file
+// the scope is normalized like the link names, so candidates don't need to be processed again
+void get_entity_scope(const cppast::cpp_entity& entity, std::string& scope,
+                      std::vector<std::size_t>& prefix_lengths)
 {
-    auto scope      = entity.scope_name();
-    auto scope_name = scope.map(&cppast::cpp_scope_name::name);
-    return type_safe::copy(scope_name).value_or("");
-}
-
-std::string get_entity_scope(const cppast::cpp_entity& entity)
-{
-    std::string result;
+    thread_local std::vector<const cppast::cpp_entity*> parents;
+    parents.clear();
     for (auto cur = entity.parent(); cur; cur = cur.value().parent())
+        parents.push_back(&cur.value());
+
+    scope.clear();
+    prefix_lengths.assign(1u, 0u);
+    for (auto iter = parents.rbegin(); iter != parents.rend(); ++iter)
     {
-        auto cur_scope = get_scope_name(cur.value());
-        if (!cur_scope.empty())
-            result = cur_scope + "::" + result;
+        auto scope_name = (*iter)->scope_name();
+        if (!scope_name || scope_name.value().name().empty())
+            continue;
+
+        auto name = scope_name.value().name();
+        std::remove_copy(name.begin(), name.end(), std::back_inserter(scope), ' ');
+        scope += "::";
+        prefix_lengths.push_back(scope.size());
     }
-    return result;
 }
 } // namespace
 
@@ -187,11 +287,9 @@ type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url> l
     // performs local lookup
     auto do_lookup = [&](const std::string& link_name)
         -> type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url> {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto                        iter = map_.find(process_link_name(link_name));
-        if (iter == map_.end())
-            return type_safe::nullvar;
-        return iter->second;
+        if (auto result = lookup(link_name))
+            return result.value();
+        return type_safe::nullvar;
     };
 
     auto external_iter = external_doc_.lower_bound(link_name);
@@ -208,13 +306,21 @@ type_safe::variant<type_safe::nullvar_t, markup::block_reference, markup::url> l
     else
     {
         // relative lookup
-        while (context)
+        if (!context)
+            return type_safe::nullvar;
+
+        // buffers are reused, so the lookup doesn't need to allocate
+        thread_local std::string              scope, candidate;
+        thread_local std::vector<std::size_t> prefix_lengths;
+        get_entity_scope(context.value(), scope, prefix_lengths);
+
+        // go from the scope of the context to the scope of the file
+        for (auto iter = prefix_lengths.rbegin(); iter != prefix_lengths.rend(); ++iter)
         {
-            if (auto result = do_lookup(get_entity_scope(context.value()) + link_name))
+            candidate.assign(scope, 0u, *iter);
+            candidate += link_name;
+            if (auto result = do_lookup(candidate))
                 return result;
-
-            // go to parent
-            context = context.value().parent();
         }
 
         return type_safe::nullvar;
@@ -401,7 +507,7 @@ void standardese::resolve_links(const cppast::diagnostic_logger& logger, const l
                                          || block.value().document().value().name()
                                                 == document.output_name().name();
                     if (!same_document
-                        || block.value().id().as_str() != get_documentation_block(entity).as_str())
+                        || block.value().id() != get_documentation_block(entity))
                         // only resolve if points to something different
                         link.resolve_destination(block.value());
                 }
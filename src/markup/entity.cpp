@@ -0,0 +1,60 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/markup/entity.hpp>
+
+#include <atomic>
+#include <new>
+
+#include "../detail/block_pool.hpp"
+
+using namespace standardese::markup;
+
+namespace
+{
+enum allocation_mode : int
+{
+    undecided,
+    global_new,
+    block_pool,
+};
+
+// the first allocation locks in the mode, so every entity is freed the way it was allocated
+std::atomic<int> mode(undecided);
+
+bool use_pool() noexcept
+{
+    auto cur = mode.load(std::memory_order_acquire);
+    if (cur == undecided
+        && mode.compare_exchange_strong(cur, global_new, std::memory_order_acq_rel))
+        return false;
+    return cur == block_pool;
+}
+} // namespace
+
+bool entity::enable_pool() noexcept
+{
+    auto cur = int(undecided);
+    mode.compare_exchange_strong(cur, block_pool, std::memory_order_acq_rel);
+    return mode.load(std::memory_order_acquire) == block_pool;
+}
+
+void* entity::operator new(std::size_t size)
+{
+    if (!use_pool())
+        return ::operator new(size);
+
+    auto ptr = standardese::detail::pool_allocate(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void entity::operator delete(void* ptr) noexcept
+{
+    if (mode.load(std::memory_order_acquire) == block_pool)
+        standardese::detail::pool_deallocate(ptr);
+    else
+        ::operator delete(ptr);
+}
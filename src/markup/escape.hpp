@@ -7,7 +7,16 @@
 
 #include <cstdio>
 #include <cstring>
-#include <ostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define STANDARDESE_DETAIL_SSE2 1
+#    include <emmintrin.h>
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#else
+#    define STANDARDESE_DETAIL_SSE2 0
+#endif
 
 namespace standardese
 {
@@ -15,60 +24,145 @@ namespace markup
 {
     namespace detail
     {
-        inline void write_html_text(std::ostream& out, const char* str)
+        // returns the escape sequence of a character in HTML text or nullptr
+        inline const char* get_html_text_escape(char c) noexcept
         {
             // implements rule 1 here:
             // https://www.owasp.org/index.php/XSS_(Cross_Site_Scripting)_Prevention_Cheat_Sheet
-            for (auto ptr = str; *ptr; ++ptr)
+            switch (c)
             {
-                auto c = *ptr;
-                if (c == '&')
-                    out << "&amp;";
-                else if (c == '<')
-                    out << "&lt;";
-                else if (c == '>')
-                    out << "&gt;";
-                else if (c == '"')
-                    out << "&quot;";
-                else if (c == '\'')
-                    out << "&#x27;";
-                else if (c == '/')
-                    out << "&#x2F;";
-                else
-                    out << c;
+            case '&':
+                return "&amp;";
+            case '<':
+                return "&lt;";
+            case '>':
+                return "&gt;";
+            case '"':
+                return "&quot;";
+            case '\'':
+                return "&#x27;";
+            case '/':
+                return "&#x2F;";
+            default:
+                return nullptr;
+            }
+        }
+
+#if STANDARDESE_DETAIL_SSE2
+        inline unsigned count_trailing_zeros(unsigned mask) noexcept
+        {
+#    if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return unsigned(index);
+#    else
+            return unsigned(__builtin_ctz(mask));
+#    endif
+        }
+#endif
+
+        // returns a pointer to the first character in [begin, end) that needs escaping in HTML
+        // text or end
+        inline const char* find_html_text_escape(const char* begin, const char* end) noexcept
+        {
+#if STANDARDESE_DETAIL_SSE2
+            // checks 16 characters at once:
+            // '&' and '\'' only differ in the lowest bit, '<' and '>' in the second lowest bit
+            auto amp_apos = _mm_set1_epi8('\'');
+            auto less_gr  = _mm_set1_epi8('>');
+            auto quot     = _mm_set1_epi8('"');
+            auto slash    = _mm_set1_epi8('/');
+            auto bit0     = _mm_set1_epi8(1);
+            auto bit1     = _mm_set1_epi8(2);
+            for (; end - begin >= 16; begin += 16)
+            {
+                auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                auto match
+                    = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(chars, bit0), amp_apos),
+                                                _mm_cmpeq_epi8(_mm_or_si128(chars, bit1), less_gr)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(chars, quot),
+                                                _mm_cmpeq_epi8(chars, slash)));
+                auto mask = unsigned(_mm_movemask_epi8(match));
+                if (mask != 0u)
+                    return begin + count_trailing_zeros(mask);
             }
+#endif
+            for (; begin != end; ++begin)
+                if (get_html_text_escape(*begin))
+                    break;
+            return begin;
         }
 
-        inline bool needs_url_escaping(char c)
+        // Output must provide write(const char*, size)
+        // runs of characters that don't need escaping are written at once
+        template <typename Output>
+        void write_html_text(Output& out, const char* str)
+        {
+            auto end = str + std::strlen(str);
+            while (true)
+            {
+                auto ptr = find_html_text_escape(str, end);
+                out.write(str, static_cast<std::size_t>(ptr - str));
+                if (ptr == end)
+                    break;
+
+                auto escaped = get_html_text_escape(*ptr);
+                out.write(escaped, std::strlen(escaped));
+                str = ptr + 1;
+            }
+        }
+
+        inline bool needs_url_escaping(char c) noexcept
         {
             // don't escape reserved URL characters
             // don't escape safe URL characters
-            char safe[] = "-_.+!*(),%#@?=;:/,+$"
-                          "0123456789"
-                          "abcdefghijklmnopqrstuvwxyz"
-                          "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-            return std::strchr(safe, c) == nullptr;
+            // i.e. "-_.+!*(),%#@?=;:/,+$", digits and ASCII letters
+            static constexpr bool safe[256] = {
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 1, 0, 1, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1,
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1,
+                0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+            };
+            return !safe[static_cast<unsigned char>(c)];
         }
 
-        inline void write_html_url(std::ostream& out, const char* url)
+        template <typename Output>
+        void write_html_url(Output& out, const char* url)
         {
-            for (auto ptr = url; *ptr; ++ptr)
+            auto run = url;
+            auto ptr = url;
+            for (; *ptr; ++ptr)
             {
                 auto c = *ptr;
+                if (c != '&' && c != '\'' && !needs_url_escaping(c))
+                    continue;
+
+                out.write(run, static_cast<std::size_t>(ptr - run));
+                run = ptr + 1;
                 if (c == '&')
-                    out << "&amp;";
+                    out.write("&amp;", 5u);
                 else if (c == '\'')
-                    out << "&#x27";
-                else if (needs_url_escaping(c))
+                    out.write("&#x27", 5u);
+                else
                 {
-                    char buf[3];
-                    std::snprintf(buf, 3, "%02X", unsigned(c));
-                    out << "%";
-                    out << buf;
+                    char buf[4];
+                    std::snprintf(buf, 4, "%%%02X", unsigned(c));
+                    out.write(buf, 3u);
                 }
-                else
-                    out << c;
             }
+            out.write(run, static_cast<std::size_t>(ptr - run));
         }
     } // namespace detail
 } // namespace markup
@@ -5,15 +5,24 @@
 #include <standardese/markup/generator.hpp>
 
 #include <fstream>
-#include <sstream>
+#include <ostream>
 
 #include <standardese/markup/document.hpp>
 
+#include "output_buffer.hpp"
+
 using namespace standardese::markup;
 
 std::string standardese::markup::render(generator gen, const entity& e)
 {
-    std::ostringstream stream;
+    std::string result;
+    render(gen, e, result);
+    return result;
+}
+
+void standardese::markup::render(const generator& gen, const entity& e, std::string& out)
+{
+    detail::string_buffer buffer(out);
+    std::ostream          stream(&buffer);
     gen(stream, e);
-    return stream.str();
 }
@@ -28,6 +28,7 @@
 #include <standardese/markup/thematic_break.hpp>
 
 #include "escape.hpp"
+#include "output_buffer.hpp"
 
 using namespace standardese::markup;
 
@@ -36,7 +37,7 @@ namespace
 class html_stream
 {
 public:
-    explicit html_stream(type_safe::object_ref<std::ostream> out, std::string prefix,
+    explicit html_stream(type_safe::object_ref<detail::output_buffer> out, std::string prefix,
                          std::string extension)
     : out_(out), prefix_(std::move(prefix)), ext_(std::move(extension)), top_level_(true),
       closing_newl_(false)
@@ -146,16 +147,16 @@ public:
     }
 
 private:
-    explicit html_stream(type_safe::object_ref<std::ostream> out, std::string prefix,
+    explicit html_stream(type_safe::object_ref<detail::output_buffer> out, std::string prefix,
                          std::string extension, std::string closing, bool closing_newl)
     : closing_(std::move(closing)), out_(out), prefix_(std::move(prefix)),
       ext_(std::move(extension)), top_level_(false), closing_newl_(closing_newl)
     {}
 
-    std::string                         closing_;
-    type_safe::object_ref<std::ostream> out_;
-    std::string                         prefix_, ext_;
-    type_safe::flag                     top_level_, closing_newl_;
+    std::string                                  closing_;
+    type_safe::object_ref<detail::output_buffer> out_;
+    std::string                                  prefix_, ext_;
+    type_safe::flag                              top_level_, closing_newl_;
 };
 
 void write_entity(html_stream& s, const entity& e);
@@ -716,7 +717,8 @@ generator standardese::markup::html_generator(const std::string& prefix,
                                               const std::string& extension) noexcept
 {
     return [prefix, extension](std::ostream& out, const entity& e) {
-        html_stream s(type_safe::ref(out), prefix, extension);
+        detail::output_buffer buffer(out);
+        html_stream           s(type_safe::ref(buffer), prefix, extension);
         write_entity(s, e);
     };
 }
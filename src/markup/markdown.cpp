@@ -7,7 +7,6 @@
 #include <cassert>
 #include <cmark-gfm.h>
 #include <ostream>
-#include <sstream>
 
 #include <standardese/markup/block.hpp>
 #include <standardese/markup/code_block.hpp>
@@ -35,6 +34,22 @@ struct options
 {
     std::string prefix, extension;
     bool        use_html;
+    generator   html; // only set if use_html is true
+};
+
+// appends escaped HTML text to a string
+class string_output
+{
+public:
+    explicit string_output(std::string& str) : str_(&str) {}
+
+    void write(const char* str, std::size_t size)
+    {
+        str_->append(str, size);
+    }
+
+private:
+    std::string* str_;
 };
 
 void build_entity(cmark_node* parent, const options& opt, const entity& e);
@@ -80,12 +95,12 @@ void build_documentation(cmark_node* parent, const options& opt, const documenta
     {
         auto html = cmark_node_new(CMARK_NODE_HTML_BLOCK);
 
-        std::ostringstream stream;
-        stream << "<span id=\"standardese-";
-        detail::write_html_text(stream, doc.id().as_output_str().c_str());
-        stream << "\"></span>\n";
+        std::string   literal = "<span id=\"standardese-";
+        string_output output(literal);
+        detail::write_html_text(output, doc.id().as_output_str().c_str());
+        literal += "\"></span>\n";
 
-        cmark_node_set_literal(html, stream.str().c_str());
+        cmark_node_set_literal(html, literal.c_str());
         cmark_node_append_child(parent, html);
     }
 
@@ -382,6 +397,53 @@ void build(cmark_node* parent, const options& opt, const block_quote& quote)
     handle_children(node, opt, quote);
 }
 
+// collects the text of a code block or inline code,
+// so the literal of the node is only set once
+void append_code_text(std::string& literal, const entity& e, bool is_block)
+{
+    switch (e.kind())
+    {
+#define STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(Kind)                                                 \
+    case entity_kind::code_block_##Kind:                                                           \
+        literal += static_cast<const code_block::Kind&>(e).string();                               \
+        break;
+
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(keyword)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(identifier)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(string_literal)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(int_literal)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(float_literal)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(punctuation)
+        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(preprocessor)
+
+#undef STANDARDESE_DETAIL_HANDLE_CODE_BLOCK
+
+    case entity_kind::text:
+        literal += static_cast<const text&>(e).string();
+        break;
+
+    case entity_kind::soft_break:
+    case entity_kind::hard_break:
+        // inline code can't span lines, CommonMark turns line endings into spaces there as well
+        literal += is_block ? '\n' : ' ';
+        break;
+
+    // code can't contain links, so only their text is kept
+    case entity_kind::external_link:
+        for (auto& child : static_cast<const external_link&>(e))
+            append_code_text(literal, child, is_block);
+        break;
+    case entity_kind::documentation_link:
+        for (auto& child : static_cast<const documentation_link&>(e))
+            append_code_text(literal, child, is_block);
+        break;
+
+    default:
+        // other entities can't be part of code
+        break;
+    }
+}
+
 void build(cmark_node* parent, const options& opt, const code_block& cb)
 {
     if (opt.use_html)
@@ -389,7 +451,8 @@ void build(cmark_node* parent, const options& opt, const code_block& cb)
         auto node = cmark_node_new(CMARK_NODE_HTML_BLOCK);
         cmark_node_append_child(parent, node);
 
-        auto html = render(html_generator(opt.prefix, opt.extension), cb);
+        std::string html;
+        render(opt.html, cb, html);
         cmark_node_set_literal(node, html.c_str());
     }
     else
@@ -400,54 +463,13 @@ void build(cmark_node* parent, const options& opt, const code_block& cb)
         if (!cb.language().empty())
             cmark_node_set_fence_info(node, cb.language().c_str());
 
-        handle_children(node, opt, cb);
+        std::string literal;
+        for (auto& child : cb)
+            append_code_text(literal, child, true);
+        cmark_node_set_literal(node, literal.c_str());
     }
 }
 
-void append_code_block_text(cmark_node* cb, const std::string& text)
-{
-    auto str = cmark_node_get_literal(cb);
-    if (str)
-        cmark_node_set_literal(cb, (str + text).c_str());
-    else
-        cmark_node_set_literal(cb, text.c_str());
-}
-
-void build(cmark_node* parent, const options&, const code_block::keyword& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::identifier& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::string_literal& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::int_literal& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::float_literal& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::punctuation& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
-void build(cmark_node* parent, const options&, const code_block::preprocessor& text)
-{
-    append_code_block_text(parent, text.string());
-}
-
 void build(cmark_node* parent, const options&, const thematic_break&)
 {
     auto node = cmark_node_new(CMARK_NODE_THEMATIC_BREAK);
@@ -456,15 +478,9 @@ void build(cmark_node* parent, const options&, const thematic_break&)
 
 void build(cmark_node* parent, const options&, const text& t)
 {
-    if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK
-        || cmark_node_get_type(parent) == CMARK_NODE_CODE)
-        append_code_block_text(parent, t.string());
-    else
-    {
-        auto text = cmark_node_new(CMARK_NODE_TEXT);
-        cmark_node_append_child(parent, text);
-        cmark_node_set_literal(text, t.string().c_str());
-    }
+    auto text = cmark_node_new(CMARK_NODE_TEXT);
+    cmark_node_append_child(parent, text);
+    cmark_node_set_literal(text, t.string().c_str());
 }
 
 void build(cmark_node* parent, const options& opt, const emphasis& emph)
@@ -483,11 +499,15 @@ void build(cmark_node* parent, const options& opt, const strong_emphasis& emph)
     handle_children(node, opt, emph);
 }
 
-void build(cmark_node* parent, const options& opt, const code& c)
+void build(cmark_node* parent, const options&, const code& c)
 {
     auto node = cmark_node_new(CMARK_NODE_CODE);
     cmark_node_append_child(parent, node);
-    handle_children(node, opt, c);
+
+    std::string literal;
+    for (auto& child : c)
+        append_code_text(literal, child, false);
+    cmark_node_set_literal(node, literal.c_str());
 }
 
 void build(cmark_node* parent, const options&, const verbatim& v)
@@ -500,24 +520,14 @@ void build(cmark_node* parent, const options&, const verbatim& v)
 
 void build(cmark_node* parent, const options&, const soft_break&)
 {
-    if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK)
-        append_code_block_text(parent, "\n");
-    else
-    {
-        auto node = cmark_node_new(CMARK_NODE_SOFTBREAK);
-        cmark_node_append_child(parent, node);
-    }
+    auto node = cmark_node_new(CMARK_NODE_SOFTBREAK);
+    cmark_node_append_child(parent, node);
 }
 
 void build(cmark_node* parent, const options&, const hard_break&)
 {
-    if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK)
-        append_code_block_text(parent, "\n");
-    else
-    {
-        auto node = cmark_node_new(CMARK_NODE_LINEBREAK);
-        cmark_node_append_child(parent, node);
-    }
+    auto node = cmark_node_new(CMARK_NODE_LINEBREAK);
+    cmark_node_append_child(parent, node);
 }
 
 cmark_node* build_link(const char* title, const char* url)
@@ -532,22 +542,15 @@ cmark_node* build_link(const char* title, const char* url)
 
 void build(cmark_node* parent, const options& opt, const external_link& link)
 {
-    if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK)
-        handle_children(parent, opt, link);
-    else
-    {
-        auto node = build_link(link.title().c_str(), link.url().as_str().c_str());
-        cmark_node_append_child(parent, node);
+    auto node = build_link(link.title().c_str(), link.url().as_str().c_str());
+    cmark_node_append_child(parent, node);
 
-        handle_children(node, opt, link);
-    }
+    handle_children(node, opt, link);
 }
 
 void build(cmark_node* parent, const options& opt, const documentation_link& link)
 {
-    if (cmark_node_get_type(parent) == CMARK_NODE_CODE_BLOCK)
-        handle_children(parent, opt, link);
-    else if (link.internal_destination())
+    if (link.internal_destination())
     {
         auto url = opt.prefix
                    + link.internal_destination()
@@ -584,11 +587,6 @@ void build_entity(cmark_node* parent, const options& opt, const entity& e)
     case entity_kind::Kind:                                                                        \
         build(parent, opt, static_cast<const Kind&>(e));                                           \
         break;
-#define STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(Kind)                                                 \
-    case entity_kind::code_block_##Kind:                                                           \
-        build(parent, opt, static_cast<const code_block::Kind&>(e));                               \
-        break;
-
         STANDARDESE_DETAIL_HANDLE(file_documentation)
         STANDARDESE_DETAIL_HANDLE(entity_documentation)
         STANDARDESE_DETAIL_HANDLE(module_documentation)
@@ -608,13 +606,6 @@ void build_entity(cmark_node* parent, const options& opt, const entity& e)
         STANDARDESE_DETAIL_HANDLE(block_quote)
 
         STANDARDESE_DETAIL_HANDLE(code_block)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(keyword)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(identifier)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(string_literal)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(int_literal)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(float_literal)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(punctuation)
-        STANDARDESE_DETAIL_HANDLE_CODE_BLOCK(preprocessor)
 
         STANDARDESE_DETAIL_HANDLE(thematic_break)
 
@@ -630,8 +621,15 @@ void build_entity(cmark_node* parent, const options& opt, const entity& e)
         STANDARDESE_DETAIL_HANDLE(documentation_link)
 
 #undef STANDARDESE_DETAIL_HANDLE
-#undef STANDARDESE_DETAIL_HANDLE_CODE_BLOCK
 
+    // the text of code blocks is collected by build() of the code block
+    case entity_kind::code_block_keyword:
+    case entity_kind::code_block_identifier:
+    case entity_kind::code_block_string_literal:
+    case entity_kind::code_block_int_literal:
+    case entity_kind::code_block_float_literal:
+    case entity_kind::code_block_punctuation:
+    case entity_kind::code_block_preprocessor:
     case entity_kind::main_document:
     case entity_kind::subdocument:
     case entity_kind::template_document:
@@ -668,7 +666,8 @@ cmark_node* build_entity(const options& opt, const entity& e)
 generator standardese::markup::markdown_generator(bool use_html, const std::string& prefix,
                                                   const std::string& extension) noexcept
 {
-    options opt{prefix, extension, use_html};
+    options opt{prefix, extension, use_html,
+                use_html ? html_generator(prefix, extension) : generator()};
     return [opt](std::ostream& out, const entity& e) {
         auto doc = build_entity(opt, e);
 
@@ -682,7 +681,7 @@ generator standardese::markup::markdown_generator(bool use_html, const std::stri
 
 generator standardese::markup::text_generator() noexcept
 {
-    options opt{"", "txt", false};
+    options opt{"", "txt", false, generator()};
     return [opt](std::ostream& out, const entity& e) {
         auto doc = build_entity(opt, e);
 
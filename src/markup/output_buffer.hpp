@@ -0,0 +1,117 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_MARKUP_OUTPUT_BUFFER_HPP_INCLUDED
+#define STANDARDESE_MARKUP_OUTPUT_BUFFER_HPP_INCLUDED
+
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace standardese
+{
+namespace markup
+{
+    namespace detail
+    {
+        // stream buffer that appends everything written to it to a string
+        class string_buffer : public std::streambuf
+        {
+        public:
+            explicit string_buffer(std::string& str) : str_(&str) {}
+
+            std::string& str() const noexcept
+            {
+                return *str_;
+            }
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                    str_->push_back(traits_type::to_char_type(c));
+                return traits_type::not_eof(c);
+            }
+
+            std::streamsize xsputn(const char* str, std::streamsize n) override
+            {
+                str_->append(str, static_cast<std::size_t>(n));
+                return n;
+            }
+
+        private:
+            std::string* str_;
+        };
+
+        // collects the output of a generator in a contiguous buffer,
+        // which is written to the stream in big pieces
+        //
+        // If the stream writes into a string_buffer anyway,
+        // the output is appended to its string directly.
+        class output_buffer
+        {
+        public:
+            explicit output_buffer(std::ostream& out) : out_(&out), target_(&buffer_)
+            {
+                // string_buffer doesn't buffer anything itself, so nothing is reordered
+                if (auto str_buf = dynamic_cast<string_buffer*>(out.rdbuf()))
+                    target_ = &str_buf->str();
+            }
+
+            output_buffer(const output_buffer&) = delete;
+            output_buffer& operator=(const output_buffer&) = delete;
+
+            ~output_buffer()
+            {
+                flush();
+            }
+
+            void write(const char* str, std::size_t size)
+            {
+                target_->append(str, size);
+                if (buffer_.size() >= flush_size)
+                    flush();
+            }
+
+            void flush()
+            {
+                if (!buffer_.empty())
+                {
+                    out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                    buffer_.clear();
+                }
+            }
+
+            output_buffer& operator<<(char c)
+            {
+                target_->push_back(c);
+                return *this;
+            }
+
+            output_buffer& operator<<(const char* str)
+            {
+                write(str, std::strlen(str));
+                return *this;
+            }
+
+            output_buffer& operator<<(const std::string& str)
+            {
+                write(str.data(), str.size());
+                return *this;
+            }
+
+        private:
+            // the buffer grows as needed until it is flushed
+            static constexpr std::size_t flush_size = 16u * 1024u;
+
+            std::ostream* out_;
+            std::string*  target_;
+            std::string   buffer_;
+        };
+    } // namespace detail
+} // namespace markup
+} // namespace standardese
+
+#endif // STANDARDESE_MARKUP_OUTPUT_BUFFER_HPP_INCLUDED
@@ -0,0 +1,62 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/bundle.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+
+#include <catch.hpp>
+
+using namespace standardese;
+
+namespace
+{
+std::string get_contents(const bundle_reader& reader, const char* name)
+{
+    auto entry = reader.lookup(name);
+    REQUIRE(entry);
+    return std::string(entry.value().data, entry.value().size);
+}
+} // namespace
+
+TEST_CASE("bundle")
+{
+    auto path = "standardese_test.bundle";
+
+    {
+        bundle_writer writer(path);
+        writer.add("a.html", "<p>a</p>\n");
+        writer.add("dir/b.md", std::string("b\0b", 3u));
+        writer.add("empty.txt", "");
+        writer.finish();
+
+        REQUIRE_THROWS_AS(writer.add("c.html", "c"), std::logic_error);
+        REQUIRE_THROWS_AS(writer.finish(), std::logic_error);
+    }
+
+    {
+        bundle_reader reader(path);
+        REQUIRE(reader.size() == 3u);
+        REQUIRE(get_contents(reader, "a.html") == "<p>a</p>\n");
+        REQUIRE(get_contents(reader, "dir/b.md") == std::string("b\0b", 3u));
+        REQUIRE(get_contents(reader, "empty.txt").empty());
+        REQUIRE(!reader.lookup("c.html"));
+    }
+
+    {
+        // finish() is not called by the destructor
+        bundle_writer writer(path);
+        writer.add("c.html", "c");
+    }
+    REQUIRE_THROWS_AS(bundle_reader(path), std::runtime_error);
+
+    {
+        std::ofstream file(path);
+        file << "not a bundle, but long enough";
+    }
+    REQUIRE_THROWS_AS(bundle_reader(path), std::runtime_error);
+
+    std::remove(path);
+}
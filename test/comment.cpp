@@ -226,6 +226,30 @@ void a(float);
         for (auto entity : c)
             REQUIRE(entity->name() == "c");
     }
+    SECTION("group in multiple files")
+    {
+        auto file_a = parse_file({}, "comment_group_a.cpp", R"(
+/// \group a
+void a(int);
+)");
+        auto file_b = parse_file({}, "comment_group_b.cpp", R"(
+/// \group a
+void a(float);
+
+/// \group a
+void a(char);
+)");
+
+        file_comment_parser parser(test_logger());
+        parser.parse(type_safe::ref(*file_a));
+        parser.parse(type_safe::ref(*file_b));
+        auto groups = parser.finish();
+
+        auto a = groups.lookup_group("a");
+        REQUIRE((a.size() == 3u));
+        for (auto entity : a)
+            REQUIRE(entity->name() == "a");
+    }
     SECTION("module")
     {
         // set synopsis to same name as module
@@ -4,6 +4,9 @@
 
 #include <standardese/comment/parser.hpp>
 
+#include <thread>
+#include <vector>
+
 #include <catch.hpp>
 
 #include <standardese/markup/generator.hpp>
@@ -483,6 +486,24 @@ It requires extra long description.</description>
 <details-section>
 <paragraph>This terminates.</paragraph>
 </details-section>
+)";
+    }
+    SECTION("single line")
+    {
+        comment = "  Returns the size (in bytes).  ";
+        xml     = R"(<brief-section>Returns the size (in bytes).</brief-section>
+)";
+    }
+    SECTION("single line section")
+    {
+        comment = R"(\returns The size, or 0.)";
+        xml     = R"(<inline-section name="Returns">The size, or 0.</inline-section>
+)";
+    }
+    SECTION("single line markup")
+    {
+        comment = R"(Returns the *size*.)";
+        xml     = R"(<brief-section>Returns the <emphasis>size</emphasis>.</brief-section>
 )";
     }
 
@@ -773,3 +794,73 @@ This is unrelated.
         REQUIRE(inlines[3].comment.metadata().module() == "d");
     }
 }
+
+TEST_CASE("cmark allocator", "[comment]")
+{
+    // the extensions insert their own nodes into the tree,
+    // they have to use the pool allocator of the parser as well,
+    // otherwise destroying the tree frees them with the wrong allocator
+    auto comment = R"(\exclude
+\unique_name foo
+
+Implicit brief. With <b>HTML</b> \verbatim and verbatim\end.
+And details
+\effects An effects section.
+\notes A note with <i>HTML</i>.
+\end
+More details, \verbatim verbatim<>\end
+\param a The parameter.
+)";
+
+    auto to_xml = [](const parse_result& result) {
+        std::string xml;
+        if (result.comment.value().brief_section())
+            xml += markup::as_xml(result.comment.value().brief_section().value());
+        for (auto& section : result.comment.value().sections())
+            xml += markup::as_xml(section);
+        for (auto& inline_ : result.inlines)
+            xml += inline_.comment.brief_section()
+                       ? markup::as_xml(inline_.comment.brief_section().value())
+                       : "";
+        return xml;
+    };
+
+    parser p;
+    auto   expected = parse(p, comment, true);
+    REQUIRE(expected.comment.value().metadata().exclude());
+    REQUIRE(expected.comment.value().metadata().unique_name() == "foo");
+    REQUIRE(expected.comment.value().brief_section());
+    REQUIRE(expected.inlines.size() == 1u);
+    auto expected_xml = to_xml(expected);
+
+    // parse on multiple threads, so the trees are created and destroyed with different pools
+    std::vector<std::string> results(4u);
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+        threads.emplace_back([&] {
+            parser thread_p;
+            for (auto i = 0; i != 16; ++i)
+                result = to_xml(parse(thread_p, comment, true));
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto& result : results)
+        REQUIRE(result == expected_xml);
+    REQUIRE(to_xml(parse(p, comment, true)) == expected_xml);
+}
+
+TEST_CASE("config", "[comment]")
+{
+    config c;
+    REQUIRE(c.try_lookup("returns") == unsigned(section_type::returns));
+    REQUIRE(c.try_lookup("returns_value", 7u) == unsigned(section_type::returns));
+    REQUIRE(c.try_lookup("exclude") == unsigned(command_type::exclude));
+    REQUIRE(c.try_lookup("param") == unsigned(inline_type::param));
+    REQUIRE(c.try_lookup("foo") == unsigned(command_type::invalid));
+    REQUIRE(c.try_lookup("") == unsigned(command_type::invalid));
+
+    c.set_command_name(section_type::returns, "return");
+    REQUIRE(c.try_lookup("return") == unsigned(section_type::returns));
+    REQUIRE(c.try_lookup("returns") == unsigned(command_type::invalid));
+}
@@ -0,0 +1,93 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/documentation_set.hpp>
+
+#include <catch.hpp>
+
+#include <standardese/markup/entity_kind.hpp>
+#include <standardese/markup/link.hpp>
+#include <standardese/markup/paragraph.hpp>
+#include <standardese/markup/phrasing.hpp>
+
+#include "test_logger.hpp"
+
+using namespace standardese;
+
+namespace
+{
+std::unique_ptr<documentation_set> get_set(std::size_t cache_size)
+{
+    std::vector<std::unique_ptr<markup::document_entity>> documents;
+
+    markup::main_document::builder a("A", "a");
+    markup::paragraph::builder      p2(markup::block_id("p2"));
+    p2.add_child(
+        markup::documentation_link::builder("p1").add_child(markup::text::build("link")).finish());
+    a.add_child(p2.finish());
+    documents.push_back(a.finish());
+
+    markup::main_document::builder b("B", "b");
+    b.add_child(markup::paragraph::builder(markup::block_id("p1")).finish());
+    documents.push_back(b.finish());
+
+    std::unique_ptr<linker> l(new linker);
+    l->register_documentation("p1", *documents.back(), markup::block_id("p1"), false);
+
+    return std::unique_ptr<documentation_set>(
+        new documentation_set({}, std::move(documents), std::move(l), test_logger(), cache_size));
+}
+} // namespace
+
+TEST_CASE("documentation_set")
+{
+    SECTION("rendering")
+    {
+        auto set = get_set(documentation_set::default_cache_size);
+        set->add_format("html", markup::html_generator("", "html"));
+
+        REQUIRE(set->lookup("a"));
+        REQUIRE(set->lookup("b"));
+        REQUIRE(!set->lookup("c"));
+
+        auto a = set->render("a", "html");
+        REQUIRE(a);
+        REQUIRE(a->find("<a href=\"b.html#standardese-p1\">link</a>") != std::string::npos);
+
+        // cached
+        REQUIRE(set->render("a", "html") == a);
+
+        REQUIRE(!set->render("c", "html"));
+        REQUIRE(!set->render("a", "xml"));
+    }
+    SECTION("lookup")
+    {
+        auto set = get_set(documentation_set::default_cache_size);
+
+        auto a = set->lookup("a");
+        REQUIRE(a);
+
+        // the links are resolved before the document is returned
+        auto resolved = false;
+        markup::visit(a.value(), [&](const markup::entity& e) {
+            if (e.kind() == markup::entity_kind::documentation_link)
+                resolved = static_cast<const markup::documentation_link&>(e)
+                               .internal_destination()
+                               .has_value();
+        });
+        REQUIRE(resolved);
+    }
+    SECTION("eviction")
+    {
+        auto set = get_set(0u);
+        set->add_format("html", markup::html_generator("", "html"));
+
+        auto a = set->render("a", "html");
+        REQUIRE(a);
+
+        auto a2 = set->render("a", "html");
+        REQUIRE(a2 != a);
+        REQUIRE(*a2 == *a);
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <standardese/interned_string.hpp>
+
+#include <catch.hpp>
+
+#include <standardese/markup/block.hpp>
+
+using namespace standardese;
+
+TEST_CASE("interned_string")
+{
+    interned_string empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.str().empty());
+    REQUIRE(empty == interned_string(""));
+
+    interned_string a("foo");
+    REQUIRE(!a.empty());
+    REQUIRE(a.str() == "foo");
+    REQUIRE(a != empty);
+
+    interned_string b(std::string("fo") + "o");
+    REQUIRE(a == b);
+    REQUIRE(&a.str() == &b.str());
+    REQUIRE(a.hash() == b.hash());
+
+    interned_string c("bar");
+    REQUIRE(a != c);
+    REQUIRE(c.str() == "bar");
+}
+
+TEST_CASE("block_id")
+{
+    markup::block_id interned(interned_string("foo"));
+    markup::block_id plain(std::string("foo"));
+    REQUIRE(interned.as_str() == "foo");
+    REQUIRE(plain.as_str() == "foo");
+    REQUIRE(interned == plain);
+    REQUIRE(interned == markup::block_id(interned_string("foo")));
+    REQUIRE(plain != markup::block_id(interned_string("bar")));
+
+    REQUIRE(markup::block_id().empty());
+    REQUIRE(markup::block_id(interned_string("")).empty());
+    REQUIRE(markup::block_id(interned_string("")) == markup::block_id());
+    REQUIRE(markup::block_id(std::string("")) == markup::block_id());
+
+    // both representations fit into a pointer
+    REQUIRE(sizeof(markup::block_id) == sizeof(interned_string));
+
+    auto copy = plain;
+    REQUIRE(copy.as_str() == "foo");
+    REQUIRE(&copy.as_str() != &plain.as_str());
+    auto moved = std::move(copy);
+    REQUIRE(moved == plain);
+    REQUIRE(copy.empty());
+
+    copy = interned;
+    REQUIRE(&copy.as_str() == &interned.as_str());
+    copy = moved;
+    REQUIRE(copy == plain);
+}
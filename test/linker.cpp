@@ -113,6 +113,14 @@ namespace ns
          void context1();
     };
 
+    template <typename T, typename U>
+    struct pair
+    {
+         void first();
+
+         void context4();
+    };
+
     void context2();
 }
 
@@ -129,6 +137,8 @@ void context3();
                                          markup::block_id("ns::type::mfunc"), false));
         REQUIRE(l.register_documentation("ns::type<T>::mfunc(int).param", *document_a,
                                          markup::block_id("ns::type::mfunc.param"), false));
+        REQUIRE(l.register_documentation("ns::pair<T, U>::first()", *document_a,
+                                         markup::block_id("ns::pair::first"), false));
 
         // lookup from context1
         auto& context1 = get_named_entity(*file, "context1");
@@ -137,6 +147,13 @@ void context3();
         REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context1), "*func"),
                                   *document_a, markup::block_id("ns::func")));
 
+        // lookup from context4, the scope contains a space
+        auto& context4 = get_named_entity(*file, "context4");
+        REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context4), "*first"),
+                                  *document_a, markup::block_id("ns::pair::first")));
+        REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context4), "*func"),
+                                  *document_a, markup::block_id("ns::func")));
+
         // lookup from context2
         auto& context2 = get_named_entity(*file, "context2");
         REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context2), "*func"),
@@ -147,6 +164,43 @@ void context3();
         REQUIRE(equal_destination(l.lookup_documentation(type_safe::ref(context3), "*func"),
                                   *document_a, markup::block_id("func")));
     }
+    SECTION("frozen")
+    {
+        REQUIRE(l.register_documentation("foo()", *document_a, markup::block_id("foo"), false));
+        REQUIRE(l.register_documentation("ns::bar<T>(int)", *document_b, markup::block_id("bar"),
+                                         false));
+        for (auto i = 0; i != 100; ++i)
+        {
+            auto name = "entity" + std::to_string(i);
+            REQUIRE(l.register_documentation(name, *document_a, markup::block_id(name), false));
+        }
+        l.freeze();
+
+        REQUIRE(equal_destination(l.lookup_documentation(nullptr, "foo"), *document_a,
+                                  markup::block_id("foo")));
+        REQUIRE(equal_destination(l.lookup_documentation(nullptr, "ns::bar<T>(int)"), *document_b,
+                                  markup::block_id("bar")));
+        REQUIRE(equal_destination(l.lookup_documentation(nullptr, "ns::bar"), *document_b,
+                                  markup::block_id("bar")));
+        for (auto i = 0; i != 100; ++i)
+        {
+            auto name = "entity" + std::to_string(i);
+            REQUIRE(equal_destination(l.lookup_documentation(nullptr, name), *document_a,
+                                      markup::block_id(name)));
+        }
+
+        REQUIRE(!l.lookup_documentation(nullptr, "bar"));
+        REQUIRE(!l.lookup_documentation(nullptr, "entity100"));
+
+        // freezing again keeps the links
+        l.freeze();
+        REQUIRE(l.is_frozen());
+        REQUIRE(equal_destination(l.lookup_documentation(nullptr, "foo"), *document_a,
+                                  markup::block_id("foo")));
+
+        REQUIRE_THROWS_AS(l.register_documentation("baz", *document_a, markup::block_id("baz")),
+                          std::logic_error);
+    }
     SECTION("external doc")
     {
         l.register_external("std", "std/$$/");
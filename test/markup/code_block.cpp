@@ -4,9 +4,14 @@
 
 #include <standardese/markup/code_block.hpp>
 
+#include <cstdlib>
+
 #include <catch.hpp>
+#include <cmark-gfm.h>
 
 #include <standardese/markup/generator.hpp>
+#include <standardese/markup/link.hpp>
+#include <standardese/markup/phrasing.hpp>
 
 using namespace standardese::markup;
 
@@ -96,3 +101,62 @@ void foo();
 ```
 )");
 }
+
+namespace
+{
+// renders a tree with a single code node the way the Markdown generator renders it
+std::string render_cmark_code(cmark_node_type root_type, cmark_node_type code_type,
+                              const char* literal, const char* fence_info)
+{
+    auto root = cmark_node_new(root_type);
+    auto node = cmark_node_new(code_type);
+    cmark_node_append_child(root, node);
+    cmark_node_set_literal(node, literal);
+    if (fence_info)
+        cmark_node_set_fence_info(node, fence_info);
+
+    auto        str = cmark_render_commonmark(root, CMARK_OPT_NOBREAKS, 0);
+    std::string result(str);
+    std::free(str);
+    cmark_node_free(root);
+    return result;
+}
+
+template <class Builder>
+void add_mixed_code(Builder& builder)
+{
+    builder.add_child(code_block::keyword::build("int"));
+    builder.add_child(text::build(" "));
+    builder.add_child(
+        documentation_link::builder("", block_reference(output_name::from_name("doc"),
+                                                        block_id("foo")))
+            .add_child(text::build("foo"))
+            .finish());
+    builder.add_child(code_block::punctuation::build("("));
+    builder.add_child(external_link::builder(url("http://foonathan.net/"))
+                          .add_child(code_block::identifier::build("bar"))
+                          .finish());
+    builder.add_child(code_block::punctuation::build(");"));
+    builder.add_child(soft_break::build());
+    builder.add_child(code_block::string_literal::build("\"`a`\""));
+    builder.add_child(hard_break::build());
+    builder.add_child(code_block::int_literal::build("42"));
+}
+} // namespace
+
+TEST_CASE("code-block markdown", "[markup]")
+{
+    // the Markdown of code has to match what cmark renders for the literal the tokens make up
+    code_block::builder block(block_id(""), "cpp");
+    add_mixed_code(block);
+    REQUIRE(render(markdown_generator(false, "", "md"), *block.finish())
+            == render_cmark_code(CMARK_NODE_DOCUMENT, CMARK_NODE_CODE_BLOCK,
+                                 "int foo(bar);\n\"`a`\"\n42", "cpp"));
+
+    // inline code has no line breaks, and the links are replaced by their text
+    code::builder inline_code;
+    add_mixed_code(inline_code);
+    REQUIRE(render(markdown_generator(false, "", "md"), *inline_code.finish())
+            == render_cmark_code(CMARK_NODE_PARAGRAPH, CMARK_NODE_CODE,
+                                 "int foo(bar); \"`a`\" 42", nullptr));
+}
@@ -4,6 +4,9 @@
 
 #include <standardese/markup/document.hpp>
 
+#include <thread>
+#include <vector>
+
 #include <catch.hpp>
 
 #include <standardese/markup/generator.hpp>
@@ -47,6 +50,45 @@ void test_main_sub_document(const char* name)
     REQUIRE(as_markdown(*doc) == md);
 }
 
+TEST_CASE("entity pool", "[markup]")
+{
+    // the test runner enables the pool before the first entity is allocated
+    REQUIRE(entity::enable_pool());
+
+    auto build = [](unsigned i) {
+        main_document::builder builder("Document " + std::to_string(i),
+                                       "doc-" + std::to_string(i));
+        for (auto j = 0u; j != 64u; ++j)
+            builder.add_child(paragraph::builder(block_id(""))
+                                  .add_child(text::build("paragraph " + std::to_string(j)))
+                                  .finish());
+        return builder.finish();
+    };
+
+    // documents of threads that have exited already,
+    // the pool of a thread is destroyed with the last of its entities
+    std::vector<std::unique_ptr<main_document>> docs(8u);
+    std::vector<std::thread>                    threads;
+    for (auto i = 0u; i != docs.size(); ++i)
+        threads.emplace_back([&, i] { docs[i] = build(i); });
+    for (auto& thread : threads)
+        thread.join();
+    for (auto i = 0u; i != docs.size(); ++i)
+        REQUIRE(docs[i]->output_name().name() == "doc-" + std::to_string(i));
+    docs.clear();
+
+    // a document destroyed by a different thread while the owning thread is still alive,
+    // the owning thread reuses the blocks afterwards
+    auto doc      = build(0u);
+    auto expected = as_xml(*doc);
+    for (auto i = 0; i != 4; ++i)
+    {
+        std::thread([&] { doc.reset(); }).join();
+        doc = build(0u);
+        REQUIRE(as_xml(*doc) == expected);
+    }
+}
+
 TEST_CASE("main_document", "[markup]")
 {
     test_main_sub_document<main_document>("main-document");
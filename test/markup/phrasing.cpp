@@ -27,6 +27,87 @@ TEST_CASE("text", "[markup]")
     REQUIRE(as_xml(*c) == "&lt;html&gt;&amp;&quot;&apos;&lt;/html&gt;");
     REQUIRE(as_markdown(*c) == R"(\<html\>&"'\</html\>
 )");
+
+    std::string out = "<p>";
+    render(html_generator("", "html"), *c, out);
+    render(xml_generator(), *a, out);
+    REQUIRE(out == "<p>&lt;html&gt;&amp;&quot;&#x27;&lt;&#x2F;html&gt;Hello World!");
+}
+
+TEST_CASE("text escaping", "[markup]")
+{
+    // escapes one character at a time, the generator checks 16 characters at once if it can
+    auto escape = [](const std::string& str) -> std::string {
+        std::string result;
+        for (auto c : str)
+            switch (c)
+            {
+            case '&':
+                result += "&amp;";
+                break;
+            case '<':
+                result += "&lt;";
+                break;
+            case '>':
+                result += "&gt;";
+                break;
+            case '"':
+                result += "&quot;";
+                break;
+            case '\'':
+                result += "&#x27;";
+                break;
+            case '/':
+                result += "&#x2F;";
+                break;
+            default:
+                result += c;
+                break;
+            }
+        return result;
+    };
+
+    auto check = [&](const std::string& str) {
+        INFO(str);
+        REQUIRE(as_html(*text::build(str)) == escape(str));
+    };
+
+    // 37 characters: two full blocks of 16 and a tail of 5
+    const std::string plain = "abcdefghijklmnopqrstuvwxyz0123456789A";
+    SECTION("no escape")
+    {
+        check(plain);
+        check(plain.substr(0u, 16u));
+        check(plain.substr(0u, 32u));
+    }
+    SECTION("single escape")
+    {
+        for (auto c : {'&', '<', '>', '"', '\'', '/'})
+            for (auto pos : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 35u, 36u})
+            {
+                auto str = plain;
+                str[pos] = c;
+                check(str);
+            }
+    }
+    SECTION("multiple escapes")
+    {
+        check(std::string(40u, '<'));
+        check("<" + plain + ">");
+        check(plain.substr(0u, 15u) + "&'" + plain.substr(0u, 14u) + "\"/" + plain);
+    }
+    SECTION("similar characters")
+    {
+        // differ from characters that need escaping in a single bit
+        check("%$()*+,-.:;=?@[]^_`{|}~ %$()*+,-.:;=?@[]^_`{|}~");
+    }
+    SECTION("non-ASCII")
+    {
+        // UTF-8 and bytes whose lower seven bits are a character that needs escaping
+        auto non_ascii = std::string("\xC3\xA4\xE2\x82\xAC\xA6\xA7\xBC\xBE\xA2\xAF\xFF\x80");
+        check(non_ascii + non_ascii + non_ascii);
+        check(non_ascii + "<" + non_ascii + "&" + non_ascii + "/");
+    }
 }
 
 template <typename T>
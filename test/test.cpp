@@ -2,6 +2,15 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
-#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_RUNNER
 #define CATCH_CONFIG_COLOUR_NONE
 #include <catch.hpp>
+
+#include <standardese/markup/entity.hpp>
+
+int main(int argc, char* argv[])
+{
+    // the tool uses the pool as well, so all tests run with it
+    standardese::markup::entity::enable_pool();
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "cache.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace standardese_tool;
+
+namespace
+{
+constexpr auto cache_file_name = "standardese.cache";
+constexpr auto cache_header    = "standardese-cache 1";
+} // namespace
+
+file_cache::file_cache(fs::path directory) : directory_(std::move(directory))
+{
+    std::ifstream in((directory_ / cache_file_name).string());
+    if (!in.is_open())
+        return;
+
+    std::string line;
+    if (!std::getline(in, line) || line != cache_header)
+        // different version, treat everything as changed
+        return;
+
+    while (std::getline(in, line))
+    {
+        // o <key> <output file name>
+        auto space = line.find(' ', 2u);
+        if (line.size() < 2u || line[1] != ' ' || space == std::string::npos)
+            continue;
+
+        try
+        {
+            auto key = std::stoull(line.substr(2u, space - 2u), nullptr, 16);
+            if (line[0] == 'o')
+                old_outputs_.emplace(line.substr(space + 1u), key);
+        }
+        catch (std::logic_error&)
+        {
+            // ignore invalid entry
+        }
+    }
+}
+
+bool file_cache::is_up_to_date(const std::string& output_file, std::uint64_t key) const
+{
+    auto iter = old_outputs_.find(output_file);
+    return iter != old_outputs_.end() && iter->second == key && fs::exists(output_file);
+}
+
+void file_cache::record_output(const std::string& output_file, std::uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    outputs_[output_file] = key;
+}
+
+void file_cache::remove_old_outputs() const
+{
+    for (auto& output : old_outputs_)
+        if (outputs_.count(output.first) == 0u)
+        {
+            boost::system::error_code ec;
+            fs::remove(output.first, ec); // it doesn't matter if the file is already gone
+        }
+}
+
+void file_cache::save() const
+{
+    fs::create_directories(directory_);
+
+    std::ofstream out((directory_ / cache_file_name).string());
+    out << cache_header << '\n' << std::hex;
+    for (auto& output : outputs_)
+        out << "o " << output.second << ' ' << output.first << '\n';
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef STANDARDESE_TOOL_CACHE_HPP_INCLUDED
+#define STANDARDESE_TOOL_CACHE_HPP_INCLUDED
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <standardese/detail/hash.hpp>
+
+#include "filesystem.hpp"
+
+namespace standardese_tool
+{
+using hasher = standardese::detail::hasher;
+
+// persistent keys of the written output files
+//
+// The key of an output file is a hash of everything that makes up its content.
+// They are stored in the cache directory between runs,
+// so unchanged output doesn't need to be written again.
+class file_cache
+{
+public:
+    // loads the cache stored in the directory, if there is one
+    explicit file_cache(fs::path directory);
+
+    file_cache(const file_cache&) = delete;
+    file_cache& operator=(const file_cache&) = delete;
+
+    // returns whether or not the output file still exists and was written with the same key
+    // in the last run
+    bool is_up_to_date(const std::string& output_file, std::uint64_t key) const;
+
+    // records the key of an output file that is up to date for the next run,
+    // must only be called once the file has been written successfully
+    // thread safe
+    void record_output(const std::string& output_file, std::uint64_t key);
+
+    // deletes the output files written in the last run that haven't been recorded in this run
+    void remove_old_outputs() const;
+
+    // writes the keys of all outputs into the directory
+    void save() const;
+
+    const fs::path& directory() const noexcept
+    {
+        return directory_;
+    }
+
+private:
+    fs::path                                       directory_;
+    std::unordered_map<std::string, std::uint64_t> old_outputs_, outputs_;
+    std::mutex                                     mutex_;
+};
+} // namespace standardese_tool
+
+#endif // STANDARDESE_TOOL_CACHE_HPP_INCLUDED
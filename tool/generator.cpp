@@ -5,6 +5,8 @@
 #include "generator.hpp"
 
 #include <fstream>
+#include <stdexcept>
+#include <streambuf>
 
 #include <standardese/index.hpp>
 #include <standardese/linker.hpp>
@@ -17,18 +19,18 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
     const cppast::libclang_compile_config&                            config,
     const type_safe::optional<cppast::libclang_compilation_database>& database,
     const std::vector<input_file>& files, const cppast::cpp_entity_index& index,
-    unsigned no_threads)
+    const standardese::file_comment_parser& comment_parser, thread_pool& pool)
 {
     std::vector<parsed_file> result;
     bool                     error(false);
     cppast::libclang_parser  parser(cppast::default_logger());
 
     {
-        std::mutex  mutex;
-        thread_pool pool(no_threads);
+        std::mutex mutex;
+        job_group  jobs(pool);
         for (auto& file : files)
         {
-            add_job(pool, [&, file] {
+            jobs.add([&, file] {
                 auto db_config = database.map([&](const cppast::libclang_compilation_database& db) {
                     return cppast::find_config_for(db, file.path.generic_string());
                 });
@@ -36,6 +38,8 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
                 auto actual_config = db_config.value_or(config);
                 auto parsed
                     = parser.parse(index, fs::canonical(file.path).generic_string(), actual_config);
+                if (parsed)
+                    comment_parser.parse(type_safe::ref(*parsed));
 
                 std::lock_guard<std::mutex> lock(mutex);
                 if (parsed)
@@ -44,6 +48,7 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
                     error = true;
             });
         }
+        jobs.wait();
     }
 
     if (error)
@@ -52,38 +57,26 @@ type_safe::optional<std::vector<parsed_file>> standardese_tool::parse(
         return std::move(result);
 }
 
-standardese::comment_registry standardese_tool::parse_comments(
-    const standardese::comment::config& config, const std::vector<parsed_file>& files,
-    unsigned no_threads)
-{
-    standardese::file_comment_parser parser(cppast::default_logger(), config);
-    {
-        thread_pool pool(no_threads);
-        for (auto& file : files)
-            add_job(pool, [&file, &parser] { parser.parse(type_safe::ref(*file.file)); });
-    }
-    return parser.finish();
-}
-
 std::vector<std::unique_ptr<standardese::doc_cpp_file>> standardese_tool::build_files(
     const standardese::comment_registry& registry, const cppast::cpp_entity_index& index,
     std::vector<parsed_file>&& files, const standardese::entity_blacklist& blacklist,
-    unsigned no_threads)
+    thread_pool& pool)
 {
     {
-        thread_pool pool(no_threads);
+        job_group jobs(pool);
         for (auto& file : files)
-            add_job(pool,
-                    [&] { standardese::exclude_entities(registry, index, blacklist, *file.file); });
+            jobs.add(
+                [&] { standardese::exclude_entities(registry, index, blacklist, *file.file); });
+        jobs.wait();
     }
 
     std::vector<std::unique_ptr<standardese::doc_cpp_file>> result;
 
     {
-        std::mutex  mutex;
-        thread_pool pool(no_threads);
+        std::mutex mutex;
+        job_group  jobs(pool);
         for (auto& file : files)
-            add_job(pool, [&] {
+            jobs.add([&] {
                 auto entity = standardese::build_doc_entities(type_safe::ref(registry), index,
                                                               std::move(file.file),
                                                               std::move(file.output_name));
@@ -91,6 +84,7 @@ std::vector<std::unique_ptr<standardese::doc_cpp_file>> standardese_tool::build_
                 std::lock_guard<std::mutex> lock(mutex);
                 result.push_back(std::move(entity));
             });
+        jobs.wait();
     }
 
     return result;
@@ -111,7 +105,7 @@ documents standardese_tool::generate(
     const standardese::generation_config& gen_config,
     const standardese::synopsis_config& syn_config, const standardese::comment_registry& comments,
     const cppast::cpp_entity_index& index, const standardese::linker& linker,
-    const std::vector<std::unique_ptr<standardese::doc_cpp_file>>& files, unsigned no_threads)
+    const std::vector<std::unique_ptr<standardese::doc_cpp_file>>& files, thread_pool& pool)
 {
     std::mutex                                                         result_mutex;
     std::vector<std::unique_ptr<standardese::markup::document_entity>> result;
@@ -121,11 +115,9 @@ documents standardese_tool::generate(
     standardese::module_index mindex;
 
     {
-        thread_pool pool(no_threads);
-
-        std::vector<std::future<void>> futures;
+        job_group jobs(pool);
         for (auto& file : files)
-            futures.push_back(add_job(pool, [&] {
+            jobs.add([&] {
                 standardese::markup::subdocument::builder document(file->output_name(),
                                                                    "doc_"
                                                                        + get_output_file_name(
@@ -144,10 +136,8 @@ documents standardese_tool::generate(
 
                 std::lock_guard<std::mutex> lock(result_mutex);
                 result.push_back(std::move(finished_doc));
-            }));
-
-        for (auto& future : futures)
-            future.get(); // to retrieve exceptions
+            });
+        jobs.wait();
     }
 
     auto eindex_doc = get_index_document(eindex.generate(gen_config.order()), "Entities",
@@ -163,19 +153,128 @@ documents standardese_tool::generate(
     standardese::register_documentations(*cppast::default_logger(), linker, *mindex_doc);
     result.push_back(std::move(mindex_doc));
 
-    for (auto& doc : result)
-        standardese::resolve_links(*cppast::default_logger(), linker, *doc);
+    // all documentations are registered, so the documents can be resolved independently
+    linker.freeze();
+    {
+        job_group jobs(pool);
+        for (auto& doc : result)
+            jobs.add([&] { standardese::resolve_links(*cppast::default_logger(), linker, *doc); });
+        jobs.wait();
+    }
+
+    return result;
+}
+
+namespace
+{
+// stream buffer that hashes everything written to it
+class hash_buffer : public std::streambuf
+{
+public:
+    std::uint64_t finish() const noexcept
+    {
+        return hasher_.finish();
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            auto ch = traits_type::to_char_type(c);
+            hasher_.combine(&ch, 1u);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* str, std::streamsize n) override
+    {
+        hasher_.combine(str, static_cast<std::size_t>(n));
+        return n;
+    }
+
+private:
+    hasher hasher_;
+};
+
+// rendered documents are collected in a buffer of at least that size before they're written
+constexpr std::size_t initial_buffer_size = 64u * 1024u;
+} // namespace
+
+document_hashes standardese_tool::hash_documents(file_cache& cache, const documents& docs,
+                                                 std::uint64_t options_hash, thread_pool& pool)
+{
+    document_hashes result{type_safe::ref(cache), std::vector<std::uint64_t>(docs.size())};
+
+    {
+        job_group jobs(pool);
+        for (auto i = 0u; i != docs.size(); ++i)
+            jobs.add([&, i] {
+                // the XML output contains everything that makes up a document,
+                // including the resolved link destinations
+                hash_buffer  buffer;
+                std::ostream out(&buffer);
+                out.write(reinterpret_cast<const char*>(&options_hash), sizeof(options_hash));
+                standardese::markup::xml_generator()(out, *docs[i]);
+
+                result.hashes[i] = buffer.finish();
+            });
+        jobs.wait();
+    }
 
     return result;
 }
 
-void standardese_tool::write_files(const documents& docs, standardese::markup::generator generator,
-                                   std::string prefix, const char* extension, unsigned no_threads)
+void standardese_tool::write_files(const documents& docs, const std::vector<output_format>& formats,
+                                   type_safe::optional_ref<const document_hashes> skip_unchanged,
+                                   type_safe::optional_ref<standardese::bundle_writer> bundle,
+                                   thread_pool&                                        pool)
 {
-    thread_pool pool(no_threads);
-    for (auto& doc : docs)
-        add_job(pool, [&] {
-            std::ofstream file(prefix + doc->output_name().file_name(extension));
-            generator(file, *doc);
+    job_group jobs(pool);
+    for (auto i = 0u; i != docs.size(); ++i)
+        jobs.add([&, i] {
+            // the buffer keeps its capacity,
+            // so it quickly reaches the size of the biggest document a worker renders
+            thread_local std::string buffer;
+            if (buffer.capacity() < initial_buffer_size)
+                buffer.reserve(initial_buffer_size);
+
+            for (auto& format : formats)
+            {
+                auto file_name
+                    = format.prefix + docs[i]->output_name().file_name(format.extension);
+                if (skip_unchanged)
+                {
+                    auto& hashes = skip_unchanged.value();
+                    if (hashes.cache->is_up_to_date(file_name, hashes.hashes[i]))
+                    {
+                        hashes.cache->record_output(file_name, hashes.hashes[i]);
+                        continue;
+                    }
+                }
+
+                buffer.clear();
+                standardese::markup::render(format.generator, *docs[i], buffer);
+
+                if (bundle)
+                    bundle.value().add(std::move(file_name), buffer);
+                else
+                {
+                    std::ofstream file(file_name);
+                    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    file.close();
+                    if (!file)
+                        throw std::runtime_error("unable to write output file '" + file_name
+                                                 + "'");
+
+                    // only now the file is known to match the key
+                    if (skip_unchanged)
+                    {
+                        auto& hashes = skip_unchanged.value();
+                        hashes.cache->record_output(file_name, hashes.hashes[i]);
+                    }
+                }
+            }
         });
+    jobs.wait();
 }
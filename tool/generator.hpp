@@ -10,14 +10,19 @@
 #include <cppast/cpp_entity_index.hpp>
 #include <cppast/cpp_file.hpp>
 #include <cppast/libclang_parser.hpp>
+#include <type_safe/optional_ref.hpp>
+#include <type_safe/reference.hpp>
 
+#include <standardese/bundle.hpp>
 #include <standardese/comment.hpp>
 #include <standardese/doc_entity.hpp>
 #include <standardese/linker.hpp>
 #include <standardese/markup/document.hpp>
 #include <standardese/markup/generator.hpp>
 
+#include "cache.hpp"
 #include "filesystem.hpp"
+#include "thread_pool.hpp"
 
 namespace standardese_tool
 {
@@ -33,20 +38,18 @@ struct parsed_file
     std::string                       output_name;
 };
 
+// parses the files and their documentation comments,
+// the comments of a file are parsed as soon as the file itself is parsed
 type_safe::optional<std::vector<parsed_file>> parse(
     const cppast::libclang_compile_config&                            config,
     const type_safe::optional<cppast::libclang_compilation_database>& database,
     const std::vector<input_file>& files, const cppast::cpp_entity_index& index,
-    unsigned no_threads);
-
-standardese::comment_registry parse_comments(const standardese::comment::config& config,
-                                             const std::vector<parsed_file>&     files,
-                                             unsigned                            no_threads);
+    const standardese::file_comment_parser& comment_parser, thread_pool& pool);
 
 std::vector<std::unique_ptr<standardese::doc_cpp_file>> build_files(
     const standardese::comment_registry& registry, const cppast::cpp_entity_index& index,
     std::vector<parsed_file>&& files, const standardese::entity_blacklist& blacklist,
-    unsigned no_threads);
+    thread_pool& pool);
 
 using documents = std::vector<std::unique_ptr<standardese::markup::document_entity>>;
 
@@ -55,10 +58,33 @@ documents generate(const standardese::generation_config& gen_config,
                    const standardese::comment_registry&  comments,
                    const cppast::cpp_entity_index& index, const standardese::linker& linker,
                    const std::vector<std::unique_ptr<standardese::doc_cpp_file>>& files,
-                   unsigned                                                       no_threads);
+                   thread_pool&                                                   pool);
+
+// the hashes of the documents for skipping unchanged output files
+struct document_hashes
+{
+    type_safe::object_ref<file_cache> cache;
+    std::vector<std::uint64_t>        hashes;
+};
+
+// hashes the content of the documents and the given hash of the output options
+document_hashes hash_documents(file_cache& cache, const documents& docs,
+                               std::uint64_t options_hash, thread_pool& pool);
+
+struct output_format
+{
+    standardese::markup::generator generator;
+    const char*                    extension;
+    std::string                    prefix;
+};
 
-void write_files(const documents& docs, standardese::markup::generator generator,
-                 std::string prefix, const char* extension, unsigned no_threads);
+// writes the documents in all the formats,
+// a document is written in every format by the same job
+// if skip_unchanged, doesn't rewrite the files of documents that haven't changed since the last run
+// if bundle is set, the files are added to it instead of written separately
+void write_files(const documents& docs, const std::vector<output_format>& formats,
+                 type_safe::optional_ref<const document_hashes> skip_unchanged,
+                 type_safe::optional_ref<standardese::bundle_writer> bundle, thread_pool& pool);
 } // namespace standardese_tool
 
 #endif // STANDARDESE_TOOL_GENERATOR_HPP_INCLUDED
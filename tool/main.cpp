@@ -167,6 +167,15 @@ type_safe::optional<cppast::libclang_compilation_database> get_compilation_datab
         return type_safe::nullopt;
 }
 
+std::unique_ptr<standardese_tool::file_cache> get_file_cache(const po::variables_map& options)
+{
+    if (auto dir = get_option<std::string>(options, "compilation.cache_dir"))
+        return std::unique_ptr<standardese_tool::file_cache>(
+            new standardese_tool::file_cache(dir.value()));
+    else
+        return nullptr;
+}
+
 std::vector<standardese_tool::input_file> get_input(const po::variables_map& options)
 {
     auto source_ext = get_option<std::vector<std::string>>(options, "input.source_ext").value();
@@ -276,6 +285,42 @@ std::vector<std::pair<standardese::markup::generator, const char*>> get_formats(
     return formats;
 }
 
+// the hash of the executable, so a different build of standardese rewrites everything
+type_safe::optional<std::uint64_t> get_build_hash(const char* exe_name)
+{
+    std::ifstream exe("/proc/self/exe", std::ios::binary);
+    if (!exe.is_open())
+        exe.open(exe_name, std::ios::binary);
+    if (!exe.is_open())
+        return type_safe::nullopt;
+
+    standardese_tool::hasher hasher;
+    char                     buffer[4096];
+    while (exe.read(buffer, sizeof(buffer)) || exe.gcount() > 0)
+        hasher.combine(buffer, static_cast<std::size_t>(exe.gcount()));
+    if (exe.bad())
+        return type_safe::nullopt;
+    return hasher.finish();
+}
+
+type_safe::optional<std::uint64_t> get_output_options_hash(const po::variables_map& options,
+                                                           const char*             exe_name)
+{
+    auto build_hash = get_build_hash(exe_name);
+    if (!build_hash)
+        return type_safe::nullopt;
+
+    standardese_tool::hasher hasher;
+    hasher.combine(build_hash.value());
+    hasher.combine(STANDARDESE_VERSION_MAJOR);
+    hasher.combine(STANDARDESE_VERSION_MINOR);
+    hasher.combine(get_option<std::string>(options, "output.link_prefix").value_or(""));
+    hasher.combine(get_option<std::string>(options, "output.link_extension").value_or(""));
+    for (auto& format : get_option<std::vector<std::string>>(options, "output.format").value())
+        hasher.combine(format);
+    return hasher.finish();
+}
+
 standardese::entity_blacklist get_blacklist(const po::variables_map& options)
 {
     standardese::entity_blacklist blacklist(
@@ -309,6 +354,9 @@ void register_external_documentations(standardese::linker& l, const po::variable
 
 int main(int argc, char* argv[])
 {
+    // must happen before the first entity is created
+    standardese::markup::entity::enable_pool();
+
     // clang-format off
     po::options_description generic("Generic options", terminal_width), configuration("Configuration", terminal_width);
     generic.add_options()
@@ -352,6 +400,8 @@ int main(int argc, char* argv[])
 
         ("compilation.commands_dir", po::value<std::string>(),
          "the directory where a compile_commands.json is located, its options have lower priority than the other ones")
+        ("compilation.cache_dir", po::value<std::string>(),
+         "the directory where the keys of the written output files are stored between runs, used by output.skip_unchanged")
         ("compilation.standard", po::value<std::string>()->default_value("c++14"),
          "the C++ standard to use for parsing, valid values are c++98/03/11/14/1z/17")
         ("compilation.include_dir,I", po::value<std::vector<std::string>>(),
@@ -393,6 +443,12 @@ int main(int argc, char* argv[])
         ("output.prefix",
          po::value<std::string>()->default_value(""),
          "a prefix that will be added to all output files")
+        ("output.skip_unchanged",
+         po::value<bool>()->implicit_value(true)->default_value(false),
+         "don't rewrite output files whose content hasn't changed since the last run and delete the ones no longer generated, requires compilation.cache_dir; "
+         "everything is still parsed and generated, changes are detected by rendering every document as XML and hashing it")
+        ("output.bundle", po::value<std::string>(),
+         "write all output files into the given bundle file instead of separate files")
         ("output.format",
          po::value<std::vector<std::string>>()->default_value(std::vector<std::string>{"commonmark"}, "{commonmark}"),
          "the output format used (html, commonmark, commonmark_html, xml, text)")
@@ -427,11 +483,12 @@ int main(int argc, char* argv[])
             print_usage(argv[0], generic, configuration);
         else
         {
-            auto no_threads = get_option<unsigned>(options, "jobs").value();
+            standardese_tool::thread_pool pool(get_option<unsigned>(options, "jobs").value());
 
             auto compile_config = get_compile_config(options);
             auto database       = get_compilation_database(options);
             auto input          = get_input(options);
+            auto cache          = get_file_cache(options);
 
             auto comment_config    = get_comment_config(options);
             auto synopsis_config   = get_synopsis_config(options);
@@ -439,8 +496,27 @@ int main(int argc, char* argv[])
 
             auto blacklist = get_blacklist(options);
 
-            auto formats = get_formats(options);
-            auto prefix  = get_option<std::string>(options, "output.prefix").value();
+            auto formats        = get_formats(options);
+            auto prefix         = get_option<std::string>(options, "output.prefix").value();
+            auto skip_unchanged = get_option<bool>(options, "output.skip_unchanged").value();
+            if (skip_unchanged && !cache)
+                throw std::invalid_argument("output.skip_unchanged requires compilation.cache_dir");
+            auto bundle_path = get_option<std::string>(options, "output.bundle");
+            if (skip_unchanged && bundle_path)
+                throw std::invalid_argument(
+                    "output.skip_unchanged can't be used with output.bundle");
+
+            type_safe::optional<std::uint64_t> options_hash;
+            if (skip_unchanged)
+            {
+                options_hash = get_output_options_hash(options, argv[0]);
+                if (!options_hash)
+                {
+                    std::clog << "warning: unable to read the standardese executable, writing all "
+                                 "output files\n";
+                    skip_unchanged = false;
+                }
+            }
 
             standardese::linker linker;
             register_external_documentations(linker, options);
@@ -449,33 +525,61 @@ int main(int argc, char* argv[])
             {
                 cppast::cpp_entity_index index;
 
-                std::clog << "parsing C++ files...\n";
-                auto parsed
-                    = standardese_tool::parse(compile_config, database, input, index, no_threads);
+                standardese::file_comment_parser comment_parser(cppast::default_logger(),
+                                                                comment_config);
+
+                std::clog << "parsing C++ files and documentation comments...\n";
+                auto parsed = standardese_tool::parse(compile_config, database, input, index,
+                                                      comment_parser, pool);
                 if (!parsed)
                     return 1;
 
-                std::clog << "parsing documentation comments...\n";
-                auto comments
-                    = standardese_tool::parse_comments(comment_config, parsed.value(), no_threads);
+                auto comments = comment_parser.finish();
                 auto files
                     = standardese_tool::build_files(comments, index, std::move(parsed.value()),
-                                                    blacklist, no_threads);
+                                                    blacklist, pool);
 
                 std::clog << "generating documentation...\n";
                 auto docs = standardese_tool::generate(generation_config, synopsis_config, comments,
-                                                       index, linker, files, no_threads);
+                                                       index, linker, files, pool);
 
+                type_safe::optional<standardese_tool::document_hashes> hashes;
+                if (skip_unchanged)
+                    hashes = standardese_tool::hash_documents(*cache, docs, options_hash.value(),
+                                                              pool);
+
+                std::vector<standardese_tool::output_format> outputs;
                 for (auto& format : formats)
                 {
-                    std::clog << "writing files in format '" << format.second << "'...\n";
-
                     auto format_prefix
                         = formats.size() > 1u ? std::string(format.second) + '/' + prefix : prefix;
-                    if (!format_prefix.empty())
+                    if (!bundle_path && !format_prefix.empty())
                         fs::create_directories(fs::path(format_prefix).parent_path());
-                    standardese_tool::write_files(docs, format.first, std::move(format_prefix),
-                                                  format.second, no_threads);
+                    outputs.push_back({std::move(format.first), format.second,
+                                       std::move(format_prefix)});
+                }
+
+                if (bundle_path)
+                {
+                    std::clog << "writing bundle '" << bundle_path.value() << "'...\n";
+                    standardese::bundle_writer bundle(bundle_path.value());
+                    standardese_tool::write_files(docs, outputs, type_safe::nullopt,
+                                                  type_safe::opt_ref(&bundle), pool);
+                    bundle.finish();
+                }
+                else
+                {
+                    std::clog << "writing files...\n";
+                    standardese_tool::write_files(docs, outputs,
+                                                  type_safe::opt_cref(hashes ? &hashes.value()
+                                                                             : nullptr),
+                                                  type_safe::nullopt, pool);
+                }
+
+                if (skip_unchanged)
+                {
+                    cache->remove_old_outputs();
+                    cache->save();
                 }
             }
             catch (std::exception& ex)
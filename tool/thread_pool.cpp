@@ -0,0 +1,158 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "thread_pool.hpp"
+
+using namespace standardese_tool;
+
+namespace
+{
+// the pool the current thread is a worker of, if any
+thread_local const thread_pool* current_pool  = nullptr;
+thread_local std::size_t        current_index = 0u;
+} // namespace
+
+thread_pool::thread_pool(unsigned no_threads) : no_queued_(0u), next_queue_(0u), stop_(false)
+{
+    no_threads = std::max(no_threads, 1u);
+
+    for (auto i = 0u; i != no_threads; ++i)
+        queues_.emplace_back(new worker_queue);
+
+    for (auto i = 0u; i != no_threads; ++i)
+        threads_.emplace_back([this, i] { run_worker(i); });
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+void thread_pool::submit(std::function<void()> job)
+{
+    auto index = current_pool == this ? current_index : next_queue_++ % queues_.size();
+
+    // increment before the job is visible, so the counter never underflows
+    ++no_queued_;
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+
+    // synchronize with a worker that is about to sleep, so the notification isn't lost
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+}
+
+bool thread_pool::try_run_job()
+{
+    auto is_worker = current_pool == this;
+    auto index     = is_worker ? current_index : 0u;
+
+    std::function<void()> job;
+    if ((is_worker && try_pop(index, job)) || try_steal(index, job))
+    {
+        --no_queued_;
+        job();
+        return true;
+    }
+    else
+        return false;
+}
+
+void thread_pool::run_worker(std::size_t index)
+{
+    current_pool  = this;
+    current_index = index;
+
+    while (true)
+    {
+        if (try_run_job())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [&] { return stop_ || no_queued_ > 0u; });
+        if (stop_ && no_queued_ == 0u)
+            break;
+    }
+}
+
+bool thread_pool::try_pop(std::size_t index, std::function<void()>& job)
+{
+    auto&                       queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool thread_pool::try_steal(std::size_t thief, std::function<void()>& job)
+{
+    for (auto i = 0u; i != queues_.size(); ++i)
+    {
+        auto&                       queue = *queues_[(thief + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+void job_group::wait()
+{
+    wait_for_jobs();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (exception_)
+    {
+        auto exception = exception_;
+        exception_     = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void job_group::wait_for_jobs() noexcept
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (no_pending_ == 0u)
+                return;
+        }
+
+        // help with the work instead of blocking
+        if (!pool_->try_run_job())
+        {
+            // the remaining jobs are running on other threads,
+            // the last one to finish wakes us up
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return no_pending_ == 0u; });
+        }
+    }
+}
+
+void job_group::finish_job()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--no_pending_ == 0u)
+        cv_.notify_all();
+}
@@ -5,27 +5,126 @@
 #ifndef STANDARDESE_THREAD_POOL_HPP_INCLUDED
 #define STANDARDESE_THREAD_POOL_HPP_INCLUDED
 
-#include <future>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
-#include <ThreadPool.h>
-
 namespace standardese_tool
 {
-using thread_pool = ::ThreadPool;
-
 inline unsigned default_no_threads()
 {
     return std::max(std::thread::hardware_concurrency(), 1u);
 }
 
-template <typename Fnc, typename... Args>
-auto add_job(thread_pool& p, Fnc f, Args&&... args)
-    -> std::future<typename std::result_of<Fnc(Args...)>::type>
+// a work-stealing scheduler
+//
+// Every worker thread has its own queue of jobs.
+// It runs the most recently added job of its own queue first
+// and steals the oldest jobs of the other queues once it runs out of work.
+// Jobs added by a worker go into its own queue,
+// jobs added by other threads are distributed among the workers.
+class thread_pool
 {
-    return p.enqueue(f, std::forward<Args>(args)...);
-}
+public:
+    explicit thread_pool(unsigned no_threads);
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // waits for all jobs to finish
+    ~thread_pool();
+
+    // schedules a job, it must not throw
+    void submit(std::function<void()> job);
+
+    // runs a single pending job on the calling thread,
+    // returns false if there was none
+    bool try_run_job();
+
+private:
+    struct worker_queue
+    {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    void run_worker(std::size_t index);
+
+    bool try_pop(std::size_t index, std::function<void()>& job);
+    bool try_steal(std::size_t thief, std::function<void()>& job);
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread>                   threads_;
+    std::atomic<std::size_t>                   no_queued_, next_queue_;
+
+    std::mutex              sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool                    stop_;
+};
+
+// a group of jobs that can be waited on
+//
+// The waiting thread runs pending jobs until all jobs of the group are finished,
+// so groups can be waited on from within a job as well.
+class job_group
+{
+public:
+    explicit job_group(thread_pool& pool) : pool_(&pool), no_pending_(0u) {}
+
+    job_group(const job_group&) = delete;
+    job_group& operator=(const job_group&) = delete;
+
+    // waits for all jobs, ignoring exceptions
+    ~job_group() noexcept
+    {
+        wait_for_jobs();
+    }
+
+    template <typename Fnc>
+    void add(Fnc f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++no_pending_;
+        }
+
+        pool_->submit([this, f] {
+            try
+            {
+                f();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!exception_)
+                    exception_ = std::current_exception();
+            }
+            finish_job();
+        });
+    }
+
+    // waits for all jobs,
+    // rethrows the first exception thrown by a job
+    void wait();
+
+private:
+    void wait_for_jobs() noexcept;
+
+    void finish_job();
+
+    thread_pool*            pool_;
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    std::size_t             no_pending_;
+    std::exception_ptr      exception_;
+};
 } // namespace standardese_tool
 
 #endif // STANDARDESE_THREAD_POOL_HPP_INCLUDED